@@ -205,7 +205,7 @@ void updateCameraUniforms()
     // Transformation matrices act differently
     // on vectors than on points.
     // The inverse-transpose is what we want.
-    Matrix4f N = M.inverse().transposed();
+    Matrix4f N = M.normalMatrix();
     loc = glGetUniformLocation(program, "N");
     glUniformMatrix4fv(loc, 1, false, N);
 }
@@ -1,12 +0,0 @@
-#ifndef VECMATH_H
-#define VECMATH_H
-
-#include "Matrix2f.h"
-#include "Matrix3f.h"
-#include "Matrix4f.h"
-#include "Quat4f.h"
-#include "Vector2f.h"
-#include "Vector3f.h"
-#include "Vector4f.h"
-
-#endif // VECMATH_H
@@ -262,21 +262,21 @@ Curve evalCircle(float radius, unsigned steps)
 	// Preallocate a curve with steps+1 CurvePoints
 	Curve R(steps + 1);
 
+	// sin and cos of t stepping from 0 to 2pi
+	const AngleTable& t = AngleTable::get(steps);
+
 	// Fill it in counterclockwise
 	for (unsigned i = 0; i <= steps; ++i)
 	{
-		// step from 0 to 2pi
-		float t = 2.0f * c_pi * float(i) / steps;
-
 		// Initialize position
 		// We're pivoting counterclockwise around the y-axis
-		R[i].V = radius * Vector3f(cos(t), sin(t), 0);
+		R[i].V = radius * Vector3f(t.cos(i), t.sin(i), 0);
 
 		// Tangent vector is first derivative
-		R[i].T = Vector3f(-sin(t), cos(t), 0);
+		R[i].T = Vector3f(-t.sin(i), t.cos(i), 0);
 
 		// Normal vector is second derivative
-		R[i].N = Vector3f(-cos(t), -sin(t), 0);
+		R[i].N = Vector3f(-t.cos(i), -t.sin(i), 0);
 
 		// Finally, binormal is facing up.
 		R[i].B = Vector3f(0, 0, 1);
@@ -301,10 +301,14 @@ void recordCurveFrames(const Curve& curve, VertexRecorder* recorder, float frame
 	const Vector3f GREEN(0, 1, 0);
 	const Vector3f BLUE(0, 0, 1);
 	
-	const Vector4f ORGN(0, 0, 0, 1);
-	const Vector4f AXISX(framesize, 0, 0, 1);
-	const Vector4f AXISY(0, framesize, 0, 1);
-	const Vector4f AXISZ(0, 0, framesize, 1);
+	// origin and the tips of the x, y and z axes
+	const Vector3f FRAME[4] = {
+		Vector3f(0, 0, 0),
+		Vector3f(framesize, 0, 0),
+		Vector3f(0, framesize, 0),
+		Vector3f(0, 0, framesize)
+	};
+	Vector3f MFRAME[4];
 
 	for (int i = 0; i < (int)curve.size(); ++i)
 	{
@@ -314,20 +318,17 @@ void recordCurveFrames(const Curve& curve, VertexRecorder* recorder, float frame
 		T.setCol(3, Vector4f(curve[i].V, 1));
  
 		// Transform orthogonal frames into model space
-		Vector4f MORGN  = T * ORGN;
-		Vector4f MAXISX = T * AXISX;
-		Vector4f MAXISY = T * AXISY;
-		Vector4f MAXISZ = T * AXISZ;
+		T.transformPoints(FRAME, MFRAME, 4);
 
 		// Record in model space
-		recorder->record_poscolor(MORGN.xyz(), RED);
-		recorder->record_poscolor(MAXISX.xyz(), RED);
+		recorder->record_poscolor(MFRAME[0], RED);
+		recorder->record_poscolor(MFRAME[1], RED);
 
-		recorder->record_poscolor(MORGN.xyz(), GREEN);
-		recorder->record_poscolor(MAXISY.xyz(), GREEN);
+		recorder->record_poscolor(MFRAME[0], GREEN);
+		recorder->record_poscolor(MFRAME[2], GREEN);
 
-		recorder->record_poscolor(MORGN.xyz(), BLUE);
-		recorder->record_poscolor(MAXISZ.xyz(), BLUE);
+		recorder->record_poscolor(MFRAME[0], BLUE);
+		recorder->record_poscolor(MFRAME[3], BLUE);
 	}
 }
 
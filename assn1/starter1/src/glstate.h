@@ -0,0 +1,39 @@
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+#include <cstdint>
+#include "gl.h"
+
+// Cached GL state. The render code sets the state below through these
+// functions instead of calling GL directly; each one remembers the last
+// value it set and skips the GL call when nothing would change.
+//
+// Code that changes the same state behind the cache's back (e.g. a GUI
+// library) must be followed by invalidateGLState().
+
+// glUseProgram
+void useProgram(uint32_t program);
+// glEnable / glDisable
+void setEnabled(GLenum cap, bool enabled);
+// glPolygonMode, for GL_FRONT_AND_BACK
+void setPolygonMode(GLenum mode);
+// glCullFace
+void setCullFace(GLenum face);
+// glLineWidth
+void setLineWidth(float width);
+// glPointSize
+void setPointSize(float size);
+
+// Forgets the cached state, so that the next call of each function
+// above reaches GL.
+void invalidateGLState();
+
+// Calls of the functions above since the last reset, for profiling.
+struct GLStateCounters {
+    uint64_t issued; // passed on to GL
+    uint64_t skipped; // dropped because the state was already set
+};
+GLStateCounters glStateCounters();
+void resetGLStateCounters();
+
+#endif
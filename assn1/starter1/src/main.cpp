@@ -16,6 +16,7 @@
 #include "surf.h"
 #include "camera.h"
 #include "vertexrecorder.h"
+#include "glstate.h"
 
 using namespace std;
 
@@ -31,9 +32,9 @@ namespace
 Camera camera;
 
 // most curves are drawn with constant color, and no lighting
-GLuint program_color;
+ShaderProgram program_color;
 // for surfaces, we apply a light+material shader
-GLuint program_light;
+ShaderProgram program_light;
 
 // These are state variables for the UI
 bool gMousePressed = false;
@@ -57,6 +58,12 @@ const float gLineLen = 0.1f;
 // curve and surfaces vertices are recorded on application
 // startup and reused when drawing each frame.
 struct Recorders {
+    Recorders() :
+        curve(VA_POS_COLOR),
+        curveFrames(VA_POS_COLOR),
+        surfaceNormals(VA_POS_COLOR)
+    {
+    }
     VertexRecorder curve;
     VertexRecorder curveFrames;
     VertexRecorder surface;
@@ -119,6 +126,16 @@ static void keyCallback(GLFWwindow* window, int key,
     case 'P':
         gPointMode = (gPointMode + 1) % 2;
         break;
+    case 't':
+    case 'T':
+    {
+        // GL state calls since the last press, see glstate.h
+        GLStateCounters counters = glStateCounters();
+        cout << "GL state calls: " << counters.issued << " issued, "
+             << counters.skipped << " skipped" << endl;
+        resetGLStateCounters();
+        break;
+    }
     default:
         cout << "Unhandled key press " << key << "." << endl;
     }
@@ -169,7 +186,7 @@ void setViewport(GLFWwindow* window)
 
 void drawAxis()
 {
-    glUseProgram(program_color);
+    useProgram(program_color.id);
     camera.SetUniforms(program_color);
 
     const Vector3f DKRED(1.0f, 0.5f, 0.5f);
@@ -182,7 +199,7 @@ void drawAxis()
     const Vector3f AXISY(0, 5, 0);
     const Vector3f AXISZ(0, 0, 5);
 
-    VertexRecorder recorder;
+    VertexRecorder recorder(VA_POS_COLOR);
     recorder.record_poscolor(ORGN, DKRED);
     recorder.record_poscolor(AXISX, DKRED);
     recorder.record_poscolor(ORGN, DKGREEN);
@@ -197,44 +214,44 @@ void drawAxis()
     recorder.record_poscolor(ORGN, GREY);
     recorder.record_poscolor(-AXISZ, GREY);
 
-    glLineWidth(3);
+    setLineWidth(3);
     recorder.draw(GL_LINES);
 }
 
 void drawCurve()
 {
-    glUseProgram(program_color);
+    useProgram(program_color.id);
     camera.SetUniforms(program_color);
 
-    glLineWidth(1);
+    setLineWidth(1);
     recorders->curve.draw(GL_LINES);
     if (gCurveMode == CURVE_MODE_WITH_NORMALS) {
-        glLineWidth(1);
+        setLineWidth(1);
         recorders->curveFrames.draw(GL_LINES);
     }
 }
 
-void updateMaterialUniforms(GLuint program)
+void updateMaterialUniforms(const ShaderProgram& program)
 {
     GLfloat diffColor[] = { 0.4f, 0.4f, 0.4f, 1 };
     GLfloat specColor[] = { 0.9f, 0.9f, 0.9f, 1 };
     GLfloat shininess[] = { 50.0f };
-    int loc = glGetUniformLocation(program, "diffColor");
+    int loc = program[U_DIFFCOLOR];
     glUniform4fv(loc, 1, diffColor);
-    loc = glGetUniformLocation(program, "specColor");
+    loc = program[U_SPECCOLOR];
     glUniform4fv(loc, 1, specColor);
-    loc = glGetUniformLocation(program, "shininess");
+    loc = program[U_SHININESS];
     glUniform1f(loc, shininess[0]);
 }
 
-void updateLightUniforms(GLuint program)
+void updateLightUniforms(const ShaderProgram& program)
 {
     GLfloat lightPos[] = { 3.0f, 3.0f, 5.0f, 1.0f };
-    int loc = glGetUniformLocation(program, "lightPos");
+    int loc = program[U_LIGHTPOS];
     glUniform4fv(loc, 1, lightPos);
 
     GLfloat lightDiff[] = { 120.0f, 120.0f, 120.0f, 1.0f };
-    loc = glGetUniformLocation(program, "lightDiff");
+    loc = program[U_LIGHTDIFF];
     glUniform4fv(loc, 1, lightDiff);
 }
 
@@ -243,34 +260,34 @@ void drawSurface()
     const bool shaded = true; // TODO add UI for this variable
     if (shaded) {
         // DRAW SHADED SURFACE
-        glUseProgram(program_light);
+        useProgram(program_light.id);
         camera.SetUniforms(program_light);
         updateMaterialUniforms(program_light);
         updateLightUniforms(program_light);
 
 
         // shade interior of polygons
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        setPolygonMode(GL_FILL);
         // This tells openGL to *not* draw backwards-facing triangles.
         // This is more efficient, and in addition it will help you
         // make sure that your triangles are drawn in the right order.
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        setEnabled(GL_CULL_FACE, true);
+        setCullFace(GL_BACK);
     } else {
         // DRAW SURFACE WIRE FRAME
-        glUseProgram(program_color);
+        useProgram(program_color.id);
         camera.SetUniforms(program_color);
 
         // don't shade polygon interior
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glLineWidth(1);
+        setPolygonMode(GL_LINE);
+        setLineWidth(1);
     }
     recorders->surface.draw(GL_TRIANGLES);
 
     // DRAW SURFACE NORMALS
     if (gSurfaceMode == SURFACE_MODE_WITH_NORMALS) {
-        glLineWidth(1);
-        glUseProgram(program_color);
+        setLineWidth(1);
+        useProgram(program_color.id);
         camera.SetUniforms(program_color);
         recorders->surfaceNormals.draw(GL_LINES);
     }
@@ -278,34 +295,34 @@ void drawSurface()
 
 void drawPoints()
 {
-    glUseProgram(program_color);
+    useProgram(program_color.id);
     camera.SetUniforms(program_color);
 
     // Setup for point drawing
-    glPointSize(4);
-    glLineWidth(1);
+    setPointSize(4);
+    setLineWidth(1);
 
-    glDisable(GL_DEPTH_TEST);
+    setEnabled(GL_DEPTH_TEST, false);
     const Vector3f COLOR(1, 1, 0.0f);
     for (int i = 0; i < (int)gCtrlPoints.size(); i++) {
         // There are relatively few control points, so we can
         // get away with recording this for each frame.
-        VertexRecorder recorder;
+        VertexRecorder recorder(VA_POS_COLOR);
         for (int j = 0; j < (int)gCtrlPoints[i].size(); j++) {
             recorder.record_poscolor(gCtrlPoints[i][j], COLOR);
         }
         recorder.draw(GL_POINTS);
         recorder.draw(GL_LINE_STRIP);
     }
-    glEnable(GL_DEPTH_TEST);
+    setEnabled(GL_DEPTH_TEST, true);
 }
 
 void initRendering()
 {
     // Clear to black
     glClearColor(0, 0, 0, 1);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    setEnabled(GL_DEPTH_TEST, true);
+    setEnabled(GL_BLEND, true);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
@@ -416,12 +433,12 @@ int main(int argc, char** argv)
     // of OpenGL. All OpenGL programs define a vertex shader
     // and a fragment shader.
     program_light = compileProgram(c_vertexshader, c_fragmentshader_light);
-    if (!program_light) {
+    if (!program_light.id) {
         printf("Cannot compile program\n");
         return -1;
     }
     program_color = compileProgram(c_vertexshader, c_fragmentshader_color);
-    if (!program_color) {
+    if (!program_color.id) {
         printf("Cannot compile program\n");
         return -1;
     }
@@ -437,6 +454,7 @@ int main(int argc, char** argv)
         // Clear the rendering window
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         setViewport(window);
+        camera.UpdateCameraBlock();
 
         if (gMousePressed) {
             drawAxis();
@@ -461,8 +479,9 @@ int main(int argc, char** argv)
     // All OpenGL resource that are created with
     // glGen* or glCreate* must be freed.
     freeVertices();
-    glDeleteProgram(program_color);
-    glDeleteProgram(program_light);
+    camera.FreeCameraBlock();
+    glDeleteProgram(program_color.id);
+    glDeleteProgram(program_light.id);
 
     glfwTerminate(); // destroy the window
     return 0;
@@ -134,14 +134,62 @@ static bool linkProgram(GLuint handle, GLuint vshader, GLuint fshader)
     return true;
 }
 
-uint32_t compileProgram(const char* vshader_src, const char* fshader_src)
+// names of the Uniform values, in order
+static const char* c_uniformNames[U_COUNT] = {
+    "M",
+    "N",
+    "diffColor",
+    "specColor",
+    "shininess",
+    "lightPos",
+    "lightDiff",
+};
+
+ShaderProgram::ShaderProgram() :
+    id(0)
 {
-    GLuint program = glCreateProgram();
+    for (int u = 0; u < U_COUNT; ++u) {
+        location[u] = -1;
+    }
+}
+
+// Looks up the locations of the active uniforms of a linked program.
+// Uniforms that are declared but unused are not active and keep
+// location -1, which the glUniform functions ignore.
+static void resolveUniforms(ShaderProgram* program)
+{
+    int count = 0;
+    glGetProgramiv(program->id, GL_ACTIVE_UNIFORMS, &count);
+    for (int i = 0; i < count; ++i) {
+        char name[256];
+        GLsizei length;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(program->id, i, sizeof(name), &length, &size, &type, name);
+        for (int u = 0; u < U_COUNT; ++u) {
+            if (strcmp(name, c_uniformNames[u]) == 0) {
+                program->location[u] = glGetUniformLocation(program->id, name);
+                break;
+            }
+        }
+    }
+}
+
+ShaderProgram compileProgram(const char* vshader_src, const char* fshader_src)
+{
+    ShaderProgram program;
+    program.id = glCreateProgram();
     GLuint vshader = compileShader(GL_VERTEX_SHADER, vshader_src);
     GLuint fshader = compileShader(GL_FRAGMENT_SHADER, fshader_src);
-    if (!linkProgram(program, vshader, fshader)) {
-        glDeleteProgram(program);
-        program = 0;
+    if (linkProgram(program.id, vshader, fshader)) {
+        resolveUniforms(&program);
+        GLuint block = glGetUniformBlockIndex(program.id, "CameraBlock");
+        if (block != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program.id, block, CAMERA_BLOCK_BINDING);
+        }
+    } else {
+        glDeleteProgram(program.id);
+        program.id = 0;
     }
     // once a program is linked
     // shader objects should be deleted
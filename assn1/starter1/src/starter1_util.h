@@ -10,9 +10,37 @@ struct GLFWwindow;
 // creates a window using GLFW and initializes an OpenGL 3.3+ context.
 GLFWwindow* createOpenGLWindow(int width, int height, const char* title);
 
-// returns 0 on error
-// program must be freed with glDeleteProgram()
-uint32_t compileProgram(const char* vertexshader, const char* fragmentshader);
+// Uniform buffer binding of CameraBlock, which compileProgram() assigns
+// to every program.
+const uint32_t CAMERA_BLOCK_BINDING = 1;
+
+// Uniforms of the shaders below, except the ones in CameraBlock.
+enum Uniform {
+    U_M,
+    U_N,
+    U_DIFFCOLOR,
+    U_SPECCOLOR,
+    U_SHININESS,
+    U_LIGHTPOS,
+    U_LIGHTDIFF,
+    U_COUNT
+};
+
+// A linked program together with the locations of its uniforms,
+// which are looked up once when the program is compiled.
+struct ShaderProgram {
+    ShaderProgram();
+
+    uint32_t id;
+    // location of each Uniform, -1 if the program does not use it
+    int location[U_COUNT];
+
+    int operator[](Uniform u) const { return location[u]; }
+};
+
+// returns a program with id 0 on error
+// program.id must be freed with glDeleteProgram()
+ShaderProgram compileProgram(const char* vertexshader, const char* fragmentshader);
 
 static const char* c_vertexshader = R"RAWSTR(
 #version 330
@@ -23,8 +51,12 @@ layout(location=0) in vec3 Position;
 layout(location=1) in vec3 Normal;
 layout(location=2) in vec3 Color;
 
-uniform mat4 P;
-uniform mat4 V;
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
 uniform mat4 M;
 uniform mat4 N;
 
@@ -65,7 +97,12 @@ in vec4 var_Color;
 in vec3 var_Normal;
 in vec3 var_Position;
 
-uniform vec3 camPos;
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
 
 uniform vec4 diffColor;
 uniform vec4 specColor;
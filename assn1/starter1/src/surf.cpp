@@ -59,16 +59,15 @@ Surface makeSurfRev(const Curve &profile, unsigned steps)
     }
 
     int n_points = profile.size();
+    const AngleTable& t = AngleTable::get(steps);
     for (size_t i = 0; i < steps; ++i) {
-        float t = 2.0f * c_pi * (float(i) / steps);
+        Matrix3f rotation_matrix(
+            t.cos(i),  0.0f, t.sin(i),
+            0.0f,      1.0f, 0.0f,
+            -t.sin(i), 0.0f, t.cos(i)
+        );
 
         for (size_t point_i = 0; point_i < n_points; ++point_i) {
-            Matrix3f rotation_matrix(
-                cos(t),  0.0f, sin(t),
-                0.0f,    1.0f, 0.0f,
-                -sin(t), 0.0,  cos(t)
-            );
-
             Vector3f new_point = rotation_matrix * profile[point_i].V;
             Vector3f new_normal = -(rotation_matrix * profile[point_i].N);
         
@@ -104,31 +103,34 @@ Surface makeGenCyl(const Curve &profile, const Curve &sweep )
     }
 
     // TODO: Here you should build the surface.  See surf.h for details.
-    for (size_t sweep_i = 0; sweep_i < sweep.size(); ++sweep_i) {
-        for (size_t profile_i = 0; profile_i < profile.size(); ++profile_i) {
-            Matrix4f M_sweep(
-                sweep[sweep_i].N[0], sweep[sweep_i].B[0], sweep[sweep_i].T[0], sweep[sweep_i].V[0],
-                sweep[sweep_i].N[1], sweep[sweep_i].B[1], sweep[sweep_i].T[1], sweep[sweep_i].V[1],
-                sweep[sweep_i].N[2], sweep[sweep_i].B[2], sweep[sweep_i].T[2], sweep[sweep_i].V[2],
-                0.0,  0.0,  0.0,  1.0
-            );
-
-            Matrix4f M_profile_point(
-                profile[profile_i].N[0], profile[profile_i].B[0], profile[profile_i].T[0], profile[profile_i].V[0],
-                profile[profile_i].N[1], profile[profile_i].B[1], profile[profile_i].T[1], profile[profile_i].V[1],
-                profile[profile_i].N[2], profile[profile_i].B[2], profile[profile_i].T[2], profile[profile_i].V[2],
-                0.0,  0.0,  0.0,  1.0
-            );
-
-            Matrix4f new_point = M_sweep * M_profile_point;
-
-            surface.VV.push_back(Vector3f(new_point(0, 3), new_point(1, 3), new_point(2, 3)));
-            surface.VN.push_back(-Vector3f(new_point(0, 0), new_point(1, 0), new_point(2, 0)));
-        }
-    }
-    
     int sweep_size = sweep.size();
     int profile_size = profile.size();
+
+    // Profile points and normals, moved into each sweep frame as a batch.
+    vector<Vector3f> profile_points(profile_size);
+    vector<Vector3f> profile_normals(profile_size);
+    for (int profile_i = 0; profile_i < profile_size; ++profile_i) {
+        profile_points[profile_i] = profile[profile_i].V;
+        profile_normals[profile_i] = profile[profile_i].N;
+    }
+
+    surface.VV.resize(sweep_size * profile_size);
+    surface.VN.resize(sweep_size * profile_size);
+    for (int sweep_i = 0; sweep_i < sweep_size; ++sweep_i) {
+        Matrix4f M_sweep(
+            sweep[sweep_i].N[0], sweep[sweep_i].B[0], sweep[sweep_i].T[0], sweep[sweep_i].V[0],
+            sweep[sweep_i].N[1], sweep[sweep_i].B[1], sweep[sweep_i].T[1], sweep[sweep_i].V[1],
+            sweep[sweep_i].N[2], sweep[sweep_i].B[2], sweep[sweep_i].T[2], sweep[sweep_i].V[2],
+            0.0,  0.0,  0.0,  1.0
+        );
+
+        M_sweep.transformPoints(profile_points.data(), &surface.VV[sweep_i * profile_size], profile_size);
+        M_sweep.transformDirections(profile_normals.data(), &surface.VN[sweep_i * profile_size], profile_size);
+    }
+    for (size_t i = 0; i < surface.VN.size(); ++i) {
+        surface.VN[i].negate();
+    }
+
     for (size_t i = 0; i < sweep.size(); ++i) {
         for (size_t j = 0; j < profile.size(); ++j) {
             int tl = j + i * profile_size;
@@ -148,11 +150,16 @@ Surface makeGenCyl(const Curve &profile, const Curve &sweep )
 
 void recordSurface(const Surface &surface, VertexRecorder* recorder) {
 	const Vector3f WIRECOLOR(0.4f, 0.4f, 0.4f);
+    // several surfaces can share a recorder, so offset the face indices
+    // by the vertices that are already in it
+    uint32_t base = (uint32_t)recorder->vertex_count();
+    for (int i=0; i<(int)surface.VV.size(); i++)
+    {
+		recorder->record(surface.VV[i], surface.VN[i], WIRECOLOR);
+    }
     for (int i=0; i<(int)surface.VF.size(); i++)
     {
-		recorder->record(surface.VV[surface.VF[i][0]], surface.VN[surface.VF[i][0]], WIRECOLOR);
-		recorder->record(surface.VV[surface.VF[i][1]], surface.VN[surface.VF[i][1]], WIRECOLOR);
-		recorder->record(surface.VV[surface.VF[i][2]], surface.VN[surface.VF[i][2]], WIRECOLOR);
+		recorder->record_triangle(base + surface.VF[i][0], base + surface.VF[i][1], base + surface.VF[i][2]);
     }
 }
 
@@ -4,96 +4,165 @@
 #include <cstdint>
 #include "gl.h"
 
-VertexRecorder::VertexRecorder():m_nverts(0)
+VertexRecorder::VertexRecorder(int attribs) :
+    m_attribs(attribs),
+    m_stride(0),
+    m_nverts(0),
+    m_vertexarray(0),
+    m_vertexbuffer(0),
+    m_indexbuffer(0),
+    m_vertexcapacity(0),
+    m_indexcapacity(0),
+    m_dirty(false)
 {
+    assert(attribs & VA_POSITION);
+    for (int i = 0; i < 3; ++i) {
+        if (attribs & (1 << i)) {
+            m_stride += 3;
+        }
+    }
+}
+
+// The GL context that was current in draw() must still be current here.
+VertexRecorder::~VertexRecorder()
+{
+    if (m_vertexarray != 0) {
+        glDeleteBuffers(1, &m_vertexbuffer);
+        glDeleteBuffers(1, &m_indexbuffer);
+        glDeleteVertexArrays(1, &m_vertexarray);
+    }
 }
 
 void VertexRecorder::record(Vector3f pos,
-            Vector3f normal)
+    Vector3f normal)
 {
-	record(pos, normal, Vector3f(1, 1, 1));
+    record(pos, normal, Vector3f(1, 1, 1));
 }
 void VertexRecorder::record_poscolor(Vector3f pos,
-	Vector3f color) {
-	record(pos, Vector3f(0, 0, 0), color);
+    Vector3f color) {
+    record(pos, Vector3f(0, 0, 0), color);
 }
 void VertexRecorder::record(Vector3f pos,
-	Vector3f normal,
-	Vector3f color) {
-    m_position.push_back(pos);
-    m_normal.push_back(normal);
-    m_color.push_back(color);
-	m_nverts++;
+    Vector3f normal,
+    Vector3f color) {
+    const Vector3f* attrib[3] = { &pos, &normal, &color };
+    for (int i = 0; i < 3; ++i) {
+        if (m_attribs & (1 << i)) {
+            m_data.push_back(attrib[i]->x());
+            m_data.push_back(attrib[i]->y());
+            m_data.push_back(attrib[i]->z());
+        }
+    }
+    m_nverts++;
+    m_dirty = true;
+}
+void VertexRecorder::record_triangle(uint32_t i, uint32_t j, uint32_t k)
+{
+    assert(i < (uint32_t)m_nverts && j < (uint32_t)m_nverts && k < (uint32_t)m_nverts);
+    m_indices.push_back(i);
+    m_indices.push_back(j);
+    m_indices.push_back(k);
+    m_dirty = true;
 }
 
-/* This implementation uploads data to the GPU on each draw call.
-   A more efficient implementation would only upload when the vertex
-   data changed. 
+/* The vertex array and buffers are created on the first draw call and
+   kept until the recorder is destroyed. Vertex data is only uploaded
+   when it changed since the last draw, so recordings that are made once
+   and drawn every frame cost no upload after the first frame.
 */
 void VertexRecorder::draw(GLenum mode)
 {
-	if (m_nverts == 0) {
-		return;
-	}
-    // upload data to GPU
-    uint32_t vertexarray;
-    glGenVertexArrays(1, &vertexarray);
-    glBindVertexArray(vertexarray);
-    uint32_t vertexbuffer[3];
-    glGenBuffers(3, vertexbuffer);
+    if (m_nverts == 0) {
+        return;
+    }
+    if (m_vertexarray == 0) {
+        glGenVertexArrays(1, &m_vertexarray);
+        glBindVertexArray(m_vertexarray);
+        glGenBuffers(1, &m_vertexbuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
+        // the element buffer binding is part of the vertex array
+        glGenBuffers(1, &m_indexbuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexbuffer);
 
-    // POSITION
-    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer[0]);
-    size_t position_nbytes = m_nverts * sizeof(m_position[0]);
-    glBufferData(GL_ARRAY_BUFFER, position_nbytes, 
-        m_position.data(), GL_DYNAMIC_DRAW);
+        // attribute i (position, normal, color) follows the
+        // stored attributes before it
+        size_t offset = 0;
+        for (int i = 0; i < 3; ++i) {
+            if (m_attribs & (1 << i)) {
+                glEnableVertexAttribArray(i);
+                glVertexAttribPointer(i,
+                    3,
+                    GL_FLOAT,
+                    GL_FALSE,
+                    m_stride * sizeof(float),
+                    (void*)offset);
+                offset += 3 * sizeof(float);
+            }
+        }
+    } else {
+        glBindVertexArray(m_vertexarray);
+    }
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0,
- 	3,
- 	GL_FLOAT,
- 	GL_FALSE,
- 	sizeof(m_position[0]),
- 	(void*)0);
+    // disabled attributes read the current generic value, which is
+    // context state and not part of the vertex array
+    if (!(m_attribs & VA_NORMAL)) {
+        glVertexAttrib3f(1, 0, 0, 0);
+    }
+    if (!(m_attribs & VA_COLOR)) {
+        glVertexAttrib3f(2, 1, 1, 1);
+    }
 
-    // NORMALS
-    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer[1]);
-    size_t normal_nbytes = m_nverts * sizeof(m_normal[0]);
-    glBufferData(GL_ARRAY_BUFFER, normal_nbytes, 
-        m_normal.data(), GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1,
- 	3,
- 	GL_FLOAT,
- 	GL_FALSE,
- 	sizeof(m_normal[0]),
- 	(void*)0);
+    if (m_dirty) {
+        upload();
+        m_dirty = false;
+    }
 
-    // COLOR
-    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer[2]);
-    size_t color_nbytes = m_nverts * sizeof(m_color[0]);
-    glBufferData(GL_ARRAY_BUFFER, color_nbytes, 
-        m_color.data(), GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2,
- 	3,
- 	GL_FLOAT,
- 	GL_FALSE,
- 	sizeof(m_color[0]),
- 	(void*)0);
+    if (m_indices.empty()) {
+        glDrawArrays(mode, 0, m_nverts);
+    } else {
+        glDrawElements(mode, (GLsizei)m_indices.size(), GL_UNSIGNED_INT, (void*)0);
+    }
+    glBindVertexArray(0);
+}
 
-    // Everything is uploaded.
-    // Now draw.
-    glDrawArrays(mode, 0, m_nverts);
+// Uploads nbytes to the buffer bound to target, in place if it fits
+// into the capacity bytes the buffer already has.
+static void uploadBuffer(GLenum target, const void* data, size_t nbytes,
+    size_t* capacity)
+{
+    if (nbytes == 0) {
+        return;
+    }
+    if (nbytes <= *capacity) {
+        glBufferSubData(target, 0, nbytes, data);
+    } else {
+        // the first upload is usually the only one (static recordings),
+        // growing the buffer means the recording changes between frames
+        glBufferData(target, nbytes, data,
+            *capacity == 0 ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+        *capacity = nbytes;
+    }
+}
 
-    // Release allocated buffers/arrays.
-    glDeleteBuffers(3, vertexbuffer);
-    glDeleteVertexArrays(1, &vertexarray);
+// The vertex array must be bound, it holds the element buffer binding.
+void VertexRecorder::upload()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
+    uploadBuffer(GL_ARRAY_BUFFER, m_data.data(),
+        m_data.size() * sizeof(float), &m_vertexcapacity);
+    uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indices.data(),
+        m_indices.size() * sizeof(uint32_t), &m_indexcapacity);
 }
+
 void VertexRecorder::clear()
 {
-	m_nverts = 0;
-	m_position.clear();
-	m_normal.clear();
-	m_color.clear();
+    m_nverts = 0;
+    m_data.clear();
+    m_indices.clear();
+    m_dirty = true;
+}
+
+int VertexRecorder::vertex_count() const
+{
+    return m_nverts;
 }
@@ -1,13 +1,38 @@
 #ifndef RECORDER_H
 #define RECORDER_H
 
+#include <cstdint>
 #include <vector>
 #include <vecmath.h>
 #include "gl.h"
 
+// Vertex attributes stored by a VertexRecorder, matching the attribute
+// locations of the shaders (0 position, 1 normal, 2 color).
+enum VertexAttribs {
+    VA_POSITION = 1 << 0,
+    VA_NORMAL = 1 << 1,
+    VA_COLOR = 1 << 2,
+
+    VA_POS = VA_POSITION,
+    VA_POS_NORMAL = VA_POSITION | VA_NORMAL,
+    VA_POS_COLOR = VA_POSITION | VA_COLOR,
+    VA_POS_NORMAL_COLOR = VA_POSITION | VA_NORMAL | VA_COLOR
+};
+
+// Records vertices into a single interleaved buffer that only holds the
+// attributes selected at construction. Attributes that are not stored are
+// dropped by record() and read by the shaders as constants: normal (0, 0, 0)
+// and color (1, 1, 1), the values record() fills in when they are omitted.
 class VertexRecorder{ 
 public:
-    VertexRecorder();
+    // attribs is a combination of VertexAttribs and must include VA_POSITION
+    explicit VertexRecorder(int attribs = VA_POS_NORMAL_COLOR);
+    // deletes the GL buffers
+    ~VertexRecorder();
+    // owns GL objects, so it cannot be copied
+    VertexRecorder(const VertexRecorder&) = delete;
+    VertexRecorder& operator=(const VertexRecorder&) = delete;
+
     // write a vertex into the CPU buffer
     void record(Vector3f pos,
                 Vector3f normal);
@@ -16,15 +41,34 @@ public:
 		        Vector3f color);
     void record_poscolor(Vector3f pos,
 		        Vector3f color);
-    // draw recorded points
+    // write a triangle into the CPU index buffer. i, j and k index the
+    // vertices recorded since the last clear(). Once a triangle is
+    // recorded, draw() draws the triangles instead of the vertices in
+    // order, so shared vertices only need to be recorded once.
+    void record_triangle(uint32_t i, uint32_t j, uint32_t k);
+    // draw recorded points, uploading them first if they changed
     void draw(GLenum mode = GL_TRIANGLES);
     // empties the recording buffer.
     void clear();
+    // number of vertices recorded since the last clear()
+    int vertex_count() const;
 private:
+    // copies the CPU buffers to the GL buffers
+    void upload();
+
+    int m_attribs; // VertexAttribs
+    int m_stride; // floats per vertex
     int m_nverts;
-    std::vector<Vector3f> m_position;
-    std::vector<Vector3f> m_normal;
-    std::vector<Vector3f> m_color;
+    std::vector<float> m_data; // interleaved position, normal, color
+    std::vector<uint32_t> m_indices; // 3 per triangle
+
+    // GL objects, created on the first draw
+    uint32_t m_vertexarray;
+    uint32_t m_vertexbuffer;
+    uint32_t m_indexbuffer;
+    size_t m_vertexcapacity; // bytes the GL buffers can hold
+    size_t m_indexcapacity;
+    bool m_dirty; // recording changed since the last upload
 };
 
 #endif
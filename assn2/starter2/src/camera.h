@@ -9,6 +9,8 @@
 #include <vecmath.h>
 #include <cstdint>
 
+struct ShaderProgram;
+
 class Camera
 {
 public:
@@ -33,7 +35,13 @@ public:
     // Apply viewport, perspective, and modeling
     // use these instead of 
     void ApplyViewport() const;
-	void SetUniforms(uint32_t program, Matrix4f M = Matrix4f::identity()) const;
+    // Upload P, V and the eye position to the CameraBlock uniform
+    // buffer read by all programs. Call once per frame before drawing.
+    void UpdateCameraBlock();
+    // Set the per-object uniforms M and N of the active program.
+	void SetUniforms(const ShaderProgram& program, Matrix4f M = Matrix4f::identity()) const;
+    // Free the uniform buffer, before the GL context is destroyed.
+    void FreeCameraBlock();
 
     Matrix4f GetPerspective() const;
     Matrix4f GetViewMatrix() const;
@@ -69,6 +77,9 @@ private:
     float   mStartDistance;
     float   mCurrentDistance;
 
+    // CameraBlock uniform buffer, created on first update
+    uint32_t mCameraBuffer;
+
     void ArcBallRotation(int x, int y);
     void PlaneTranslation(int x, int y);
     void DistanceZoom(int x, int y);
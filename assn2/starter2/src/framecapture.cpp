@@ -0,0 +1,175 @@
+#include "framecapture.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+FrameCapture::FrameCapture(PngEffort recordEffort, int threads) :
+    m_writer(threads),
+    m_next(0),
+    m_screenshot(false),
+    m_recording(false),
+    m_recordEffort(recordEffort),
+    m_frame(0)
+{
+    for (Readback& readback : m_ring) {
+        readback.buffer = 0;
+        readback.capacity = 0;
+        readback.width = 0;
+        readback.height = 0;
+        readback.fence = nullptr;
+        readback.effort = PNG_DEFAULT;
+        readback.report = false;
+    }
+}
+
+FrameCapture::~FrameCapture()
+{
+    stopRecording();
+    // oldest first, so that recorded frames are queued in order
+    for (int i = 0; i < RING_SIZE; ++i) {
+        Readback& readback = m_ring[(m_next + i) % RING_SIZE];
+        collect(readback, true);
+        if (readback.buffer != 0) {
+            glDeleteBuffers(1, &readback.buffer);
+        }
+    }
+    m_writer.wait();
+}
+
+void FrameCapture::screenshot()
+{
+    m_screenshot = true;
+}
+
+void FrameCapture::startRecording(const std::string& prefix)
+{
+    m_prefix = prefix;
+    m_frame = 0;
+    m_recording = true;
+}
+
+void FrameCapture::stopRecording()
+{
+    if (m_recording && m_frame > 0) {
+        printf("Recorded %s_%05d.png to %s_%05d.png\n", m_prefix.c_str(), 0,
+            m_prefix.c_str(), m_frame - 1);
+    }
+    m_recording = false;
+}
+
+bool FrameCapture::recording() const
+{
+    return m_recording;
+}
+
+void FrameCapture::endFrame(GLFWwindow* window)
+{
+    // readbacks finish in order, so stop at the first that has not
+    for (int i = 0; i < RING_SIZE; ++i) {
+        Readback& readback = m_ring[(m_next + i) % RING_SIZE];
+        if (readback.fence != nullptr && !collect(readback, false)) {
+            break;
+        }
+    }
+
+    if (m_recording) {
+        char filename[256];
+        snprintf(filename, sizeof(filename), "%s_%05d.png", m_prefix.c_str(), m_frame++);
+        read(window, filename, m_recordEffort, false);
+    }
+    if (m_screenshot) {
+        char filename[80];
+        snprintf(filename, sizeof(filename), "out_%lu.png", (unsigned long)time(nullptr));
+        read(window, filename, PNG_DEFAULT, true);
+        m_screenshot = false;
+    }
+}
+
+/* glReadPixels into a bound pixel pack buffer only queues the copy, the
+   CPU does not wait for the frame to finish rendering. If all buffers
+   of the ring are still in flight, which takes the GPU running three
+   frames behind, the oldest one is waited for rather than dropped.
+*/
+void FrameCapture::read(GLFWwindow* window, const std::string& filename, PngEffort effort,
+    bool report)
+{
+    Readback& readback = m_ring[m_next];
+    m_next = (m_next + 1) % RING_SIZE;
+    collect(readback, true);
+
+    int w, h;
+    glfwGetFramebufferSize(window, &w, &h);
+    size_t nbytes = (size_t)w * h * 4;
+    if (readback.buffer == 0) {
+        glGenBuffers(1, &readback.buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (nbytes > readback.capacity) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, nbytes, nullptr, GL_STREAM_READ);
+        readback.capacity = nbytes;
+    }
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.width = w;
+    readback.height = h;
+    readback.filename = filename;
+    readback.effort = effort;
+    readback.report = report;
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool FrameCapture::collect(Readback& readback, bool wait)
+{
+    if (readback.fence == nullptr) {
+        return true;
+    }
+    GLuint64 timeout = wait ? 1000000000 : 0;
+    GLenum status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+    if (status == GL_TIMEOUT_EXPIRED && !wait) {
+        return false;
+    }
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+    // the copy has not finished after a second, or the wait itself
+    // failed: the buffer may not hold the frame, so it is not written
+    if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+        printf("Dropping frame %s: %s\n", readback.filename.c_str(),
+            status == GL_WAIT_FAILED ? "waiting for the readback failed" : "the readback timed out");
+        return true;
+    }
+
+    // glReadPixels reads upside-down; flip whole rows while copying
+    // out of the mapped buffer
+    int w = readback.width;
+    int h = readback.height;
+    size_t rowbytes = (size_t)w * 4;
+    std::vector<uint8_t> image(rowbytes * h);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    const uint8_t* pixels = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER,
+        0, rowbytes * h, GL_MAP_READ_BIT);
+    if (pixels != nullptr) {
+        for (int y = 0; y < h; ++y) {
+            memcpy(&image[(h - 1 - y) * rowbytes], pixels + y * rowbytes, rowbytes);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (pixels == nullptr) {
+        printf("Dropping frame %s: mapping the readback failed\n", readback.filename.c_str());
+        return true;
+    }
+
+    // blocks while the encoders are a full queue behind
+    m_writer.setEffort(readback.effort);
+    m_writer.write(readback.filename, std::move(image), w, h, readback.report);
+    return true;
+}
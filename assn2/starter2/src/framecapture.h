@@ -0,0 +1,78 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <cstdint>
+#include <string>
+#include "gl.h"
+#include "pngwriter.h"
+
+struct GLFWwindow;
+
+/* Writes frames to PNG files without stalling the render thread.
+   A frame is read into one of a ring of pixel buffer objects, which
+   returns at once; the buffer is mapped a frame or two later, when the
+   GPU has finished the copy, and the PNG is encoded on a worker thread.
+   Continuous recording writes every frame this way; if the encoders
+   fall behind, endFrame() waits for them rather than queueing frames.
+
+   All methods must be called on the thread that owns the GL context.
+*/
+class FrameCapture {
+public:
+    // recordEffort is the compression of recorded frames, screenshots
+    // use PNG_DEFAULT. threads is the number of PNG encoding threads,
+    // 0 for all but one core.
+    explicit FrameCapture(PngEffort recordEffort = PNG_FAST, int threads = 0);
+    // writes the frames still in flight and deletes the buffers. The GL
+    // context must still be current.
+    ~FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // write the next frame to out_<time>.png
+    void screenshot();
+    // write every frame to <prefix>_00000.png, <prefix>_00001.png, ...
+    // Recorded frames are not printed one by one, stopRecording() prints
+    // the range of files instead.
+    void startRecording(const std::string& prefix);
+    void stopRecording();
+    bool recording() const;
+
+    // Call once per frame, after drawing and before swapping buffers.
+    // Starts reading the frame back if it is to be written, and passes
+    // the frames whose readback has finished to the encoding threads.
+    void endFrame(GLFWwindow* window);
+
+private:
+    // a frame being read back into a pixel buffer object
+    struct Readback {
+        uint32_t buffer;
+        size_t capacity; // bytes
+        int width;
+        int height;
+        GLsync fence; // null if the readback is not in use
+        std::string filename;
+        PngEffort effort;
+        bool report; // print the file once written
+    };
+    static const int RING_SIZE = 3;
+
+    // starts reading the back buffer into the next readback
+    void read(GLFWwindow* window, const std::string& filename, PngEffort effort, bool report);
+    // if the readback has finished, or always if wait is set, hands it
+    // to the encoders and frees it. Returns true if it was freed. A
+    // readback that fails, or is not done a second into the wait, is
+    // freed without writing the frame, and the dropped file is printed.
+    bool collect(Readback& readback, bool wait);
+
+    PngSequenceWriter m_writer;
+    Readback m_ring[RING_SIZE];
+    int m_next; // readback used by the next read(), the oldest one
+    bool m_screenshot;
+    bool m_recording;
+    PngEffort m_recordEffort;
+    std::string m_prefix;
+    int m_frame; // number of the next recorded frame
+};
+
+#endif
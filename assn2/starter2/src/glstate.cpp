@@ -0,0 +1,117 @@
+#include "glstate.h"
+
+namespace {
+
+// glEnable capabilities that are cached, others are always passed on
+const GLenum c_caps[] = {
+    GL_DEPTH_TEST,
+    GL_CULL_FACE,
+    GL_BLEND,
+    GL_RASTERIZER_DISCARD,
+};
+const int NUM_CAPS = sizeof(c_caps) / sizeof(c_caps[0]);
+
+// Last value set through the functions in glstate.h. Each value has a
+// known flag instead of a sentinel, since every value is a valid state.
+struct GLState {
+    bool programKnown;
+    uint32_t program;
+    bool capKnown[NUM_CAPS];
+    bool capEnabled[NUM_CAPS];
+    bool polygonModeKnown;
+    GLenum polygonMode;
+    bool cullFaceKnown;
+    GLenum cullFace;
+    bool lineWidthKnown;
+    float lineWidth;
+    bool pointSizeKnown;
+    float pointSize;
+};
+
+// zero initialized, so nothing is known before the first call
+GLState s_state;
+GLStateCounters s_counters;
+
+// Returns true if the call has to be issued, and records the new value.
+template <typename T>
+bool changes(bool* known, T* current, T value)
+{
+    if (*known && *current == value) {
+        ++s_counters.skipped;
+        return false;
+    }
+    *known = true;
+    *current = value;
+    ++s_counters.issued;
+    return true;
+}
+
+} // namespace
+
+void useProgram(uint32_t program)
+{
+    if (changes(&s_state.programKnown, &s_state.program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void setEnabled(GLenum cap, bool enabled)
+{
+    int i = 0;
+    while (i < NUM_CAPS && c_caps[i] != cap) {
+        ++i;
+    }
+    if (i == NUM_CAPS) {
+        ++s_counters.issued;
+    } else if (!changes(&s_state.capKnown[i], &s_state.capEnabled[i], enabled)) {
+        return;
+    }
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+}
+
+void setPolygonMode(GLenum mode)
+{
+    if (changes(&s_state.polygonModeKnown, &s_state.polygonMode, mode)) {
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+    }
+}
+
+void setCullFace(GLenum face)
+{
+    if (changes(&s_state.cullFaceKnown, &s_state.cullFace, face)) {
+        glCullFace(face);
+    }
+}
+
+void setLineWidth(float width)
+{
+    if (changes(&s_state.lineWidthKnown, &s_state.lineWidth, width)) {
+        glLineWidth(width);
+    }
+}
+
+void setPointSize(float size)
+{
+    if (changes(&s_state.pointSizeKnown, &s_state.pointSize, size)) {
+        glPointSize(size);
+    }
+}
+
+void invalidateGLState()
+{
+    s_state = GLState();
+}
+
+GLStateCounters glStateCounters()
+{
+    return s_counters;
+}
+
+void resetGLStateCounters()
+{
+    s_counters = GLStateCounters();
+}
@@ -6,14 +6,14 @@
 
 struct Joint
 {
-	Matrix4f transform; // transform relative to its parent
+	Affine3f transform; // transform relative to its parent
 	std::vector< Joint* > children; // list of children
 
 	// This matrix transforms world space into joint space for the initial ("bind") configuration of the joints.
-	Matrix4f bindWorldToJointTransform;
+	Affine3f bindWorldToJointTransform;
 
 	// This matrix maps joint space into world space for the *current* configuration of the joints.
-	Matrix4f currentJointToWorldTransform;
+	Affine3f currentJointToWorldTransform;
 };
 
 #endif
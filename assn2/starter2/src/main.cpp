@@ -14,6 +14,9 @@
 #include "starter2_util.h"
 #include "camera.h"
 #include "vertexrecorder.h"
+#include "glstate.h"
+#include "framecapture.h"
+#include "streambuffer.h"
 #include "skeletalmodel.h"
 
 using namespace std;
@@ -32,6 +35,8 @@ const string jointNames[NJOINTS] = { "Root", "Chest", "Waist", "Neck",
 // Global variables here.
 GLFWwindow* window;
 ng::Screen *screen;
+// screenshots and frame recording, see the buttons in initGUI()
+FrameCapture* frameCapture;
 Vector3f g_jointangles[NJOINTS];
 
 // This assignment uses a useful camera implementation
@@ -39,7 +44,7 @@ Camera camera;
 SkeletalModel* skeleton;
 
 // most curves are drawn with constant color, and no lighting
-GLuint program_color;
+ShaderProgram program_color;
 
 // These are state variables for the UI
 bool gMousePressed = false;
@@ -76,6 +81,28 @@ static void keyCallback(GLFWwindow* window, int key,
     case 'A':
         gDrawAxisAlways = !gDrawAxisAlways;
         break;
+    case 'G':
+        skeleton->setGpuSkinning(!skeleton->gpuSkinning());
+        cout << (skeleton->gpuSkinning() ? "GPU" : "CPU") << " skinning" << endl;
+        break;
+    case 'N':
+        // faceted (per triangle) or smooth (per vertex) mesh normals
+        skeleton->setSmoothShading(!skeleton->smoothShading());
+        cout << (skeleton->smoothShading() ? "smooth" : "faceted") << " shading" << endl;
+        break;
+    case 'V':
+        // validate GPU skinning against updateMesh()
+        cout << "GPU - CPU skinning difference: " << skeleton->compareGpuSkinning() << endl;
+        break;
+    case 'T':
+    {
+        // GL state calls since the last press, see glstate.h
+        GLStateCounters counters = glStateCounters();
+        cout << "GL state calls: " << counters.issued << " issued, "
+             << counters.skipped << " skipped" << endl;
+        resetGLStateCounters();
+        break;
+    }
     default:
         cout << "Unhandled key press " << key << "." << endl;
     }
@@ -129,7 +156,7 @@ void setViewport(GLFWwindow* window)
 
 void drawAxis()
 {
-    glUseProgram(program_color);
+    useProgram(program_color.id);
     Matrix4f M = Matrix4f::translation(camera.GetCenter()).inverse();
     camera.SetUniforms(program_color, M);
 
@@ -143,7 +170,7 @@ void drawAxis()
     const Vector3f AXISY(0, 5, 0);
     const Vector3f AXISZ(0, 0, 5);
 
-    VertexRecorder recorder;
+    VertexRecorder recorder(VA_POS_COLOR);
     recorder.record_poscolor(ORGN, DKRED);
     recorder.record_poscolor(AXISX, DKRED);
     recorder.record_poscolor(ORGN, DKGREEN);
@@ -158,7 +185,7 @@ void drawAxis()
     recorder.record_poscolor(ORGN, GREY);
     recorder.record_poscolor(-AXISZ, GREY);
 
-    glLineWidth(3);
+    setLineWidth(3);
     recorder.draw(GL_LINES);
 }
 
@@ -166,8 +193,8 @@ void initRendering()
 {
     // Clear to black
     glClearColor(0, 0, 0, 1);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    setEnabled(GL_DEPTH_TEST, true);
+    setEnabled(GL_BLEND, true);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
@@ -175,8 +202,11 @@ void updateMesh()
 {
     // Update the bone to world transforms for SSD.
     skeleton->updateCurrentJointToWorldTransforms();
-    // update the mesh given the new skeleton
-    skeleton->updateMesh();
+    // update the mesh given the new skeleton,
+    // unless it is skinned in the vertex shader
+    if (!skeleton->gpuSkinning()) {
+        skeleton->updateMesh();
+    }
 }
 
 /*
@@ -230,8 +260,17 @@ void initGUI(GLFWwindow* glfwwin) {
         }
         if (i == 0) {
             ng::Button* btn = new ng::Button(animator, "Take Screenshot");
-            btn->setCallback([glfwwin]() {
-                screencapture(glfwwin);
+            btn->setCallback([]() {
+                frameCapture->screenshot();
+            });
+            ng::Button* record = new ng::Button(animator, "Record Frames");
+            record->setFlags(ng::Button::ToggleButton);
+            record->setChangeCallback([](bool pushed) {
+                if (pushed) {
+                    frameCapture->startRecording("frame");
+                } else {
+                    frameCapture->stopRecording();
+                }
             });
         }
 
@@ -381,6 +420,7 @@ int main(int argc, char** argv)
 
     window = createOpenGLWindow(1024, 1024, "Assignment 2");
 
+    frameCapture = new FrameCapture();
     initGUI(window);
     initRendering();
 
@@ -388,7 +428,7 @@ int main(int argc, char** argv)
     // of OpenGL. All OpenGL programs define a vertex shader
     // and a fragment shader.
     program_color = compileProgram(c_vertexshader, c_fragmentshader_color);
-    if (!program_color) {
+    if (!program_color.id) {
         printf("Cannot compile program\n");
         return -1;
     }
@@ -407,15 +447,20 @@ int main(int argc, char** argv)
         // Draw nanogui
         screen->drawContents();
         screen->drawWidgets();
-        glEnable(GL_DEPTH_TEST);
+        // nanogui sets GL state without going through glstate.h
+        invalidateGLState();
+        setEnabled(GL_DEPTH_TEST, true);
 
         setViewport(window);
+        camera.UpdateCameraBlock();
 
         if (gDrawAxisAlways || gMousePressed) {
             drawAxis();
         }
 
         skeleton->draw(camera, gDrawSkeleton);
+        endStreamFrame();
+        frameCapture->endFrame(window);
 
         // Make back buffer visible
         glfwSwapBuffers(window);
@@ -428,7 +473,12 @@ int main(int argc, char** argv)
     // All OpenGL resource that are created with
     // glGen* or glCreate* must be freed.
     freeGUI();
-    glDeleteProgram(program_color);
+    delete frameCapture; // finishes writing the captured frames
+    frameCapture = nullptr;
+    freePrimitives();
+    freeFrameStream();
+    camera.FreeCameraBlock();
+    glDeleteProgram(program_color.id);
 
     glfwTerminate(); // destroy the window
     return 0;
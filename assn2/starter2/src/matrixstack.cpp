@@ -3,7 +3,7 @@
 MatrixStack::MatrixStack()
 {
 	// Initialize the matrix stack with the identity matrix.
-	m_matrices.push_back(Matrix4f::identity());
+	m_matrices.push_back(Affine3f::identity());
 
 }
 
@@ -11,10 +11,10 @@ void MatrixStack::clear()
 {
 	// Revert to just containing the identity matrix.
 	m_matrices.clear();
-	m_matrices.push_back(Matrix4f::identity());
+	m_matrices.push_back(Affine3f::identity());
 }
 
-Matrix4f MatrixStack::top()
+Affine3f MatrixStack::top()
 {
 	// Return the top of the stack
 	// return Matrix4f();
@@ -22,13 +22,13 @@ Matrix4f MatrixStack::top()
     return m_matrices.back();
 }
 
-void MatrixStack::push( const Matrix4f& m )
+void MatrixStack::push( const Affine3f& m )
 {
 	// Push m onto the stack.
 	// The new top should be "old * m", so that conceptually the new matrix
     // is applied first in right-to-left evaluation.
 
-	Matrix4f newMatrix = top() * m;
+	Affine3f newMatrix = top() * m;
 	m_matrices.push_back(newMatrix);
 }
 
@@ -9,12 +9,12 @@ class MatrixStack
 public:
 	MatrixStack();
 	void clear();
-	Matrix4f top();
-	void push( const Matrix4f& m );
+	Affine3f top();
+	void push( const Affine3f& m );
 	void pop();
 
 private:
-	std::vector< Matrix4f > m_matrices;
+	std::vector< Affine3f > m_matrices;
 };
 
 #endif // MATRIX_STACK_H
@@ -46,22 +46,63 @@ void Mesh::draw()
 	// Notice that since we have per-triangle normals
 	// rather than the analytical normals from
 	// assignment 1, the appearance is "faceted".
+	//
+	// The vertices are shared between triangles and drawn indexed, so
+	// the per-triangle normal is computed in the fragment shader
+	// (flatShading) and only positions are recorded. Vertex normals are
+	// only needed for smoothShading.
+	std::vector< Vector3f > normals;
+	if (smoothShading) {
+		normals = computeNormals(currentVertices);
+	}
+	VertexRecorder& rec = smoothShading ? recorder : flatRecorder;
+
+	// the vertices move every frame, so they are re-recorded and
+	// streamed; the faces do not, so they are recorded once
+	rec.clear_vertices();
+	for (size_t i = 0; i < currentVertices.size(); ++i) {
+		// flatRecorder does not store the normal
+		rec.record(currentVertices[i],
+			smoothShading ? normals[i] : Vector3f(0.0f, 0.0f, 0.0f));
+	}
+	if (rec.index_count() == 0) {
+		for (auto& face : faces) {
+			rec.record_triangle(face[0], face[1], face[2]);
+		}
+	}
+
+	rec.draw();
+}
 
-	VertexRecorder rec;
-	// for (size_t i = 0; i < faces.size(); ++i) {
+// Each vertex gets the sum of the normals of its triangles, weighted by
+// triangle area, for smoothShading.
+std::vector< Vector3f > Mesh::computeNormals(const std::vector< Vector3f >& vertices) const
+{
+	std::vector< Vector3f > normals(vertices.size(), Vector3f(0.0f, 0.0f, 0.0f));
 	for (auto& face : faces) {
-		Vector3f v_0 = currentVertices[face[0]];
-		Vector3f v_1 = currentVertices[face[1]];
-		Vector3f v_2 = currentVertices[face[2]];
+		Vector3f v_0 = vertices[face[0]];
+		Vector3f v_1 = vertices[face[1]];
+		Vector3f v_2 = vertices[face[2]];
 
 		Vector3f n = Vector3f::cross(v_1 - v_0, v_2 - v_0);
 
-		rec.record(v_0, n);
-		rec.record(v_1, n);
-		rec.record(v_2, n);
+		normals[face[0]] += n;
+		normals[face[1]] += n;
+		normals[face[2]] += n;
 	}
+	return normals;
+}
 
-	rec.draw();
+void Mesh::recordBindPose(VertexRecorder* bindRecorder) const
+{
+	std::vector< Vector3f > normals = computeNormals(bindVertices);
+	bindRecorder->clear();
+	for (size_t i = 0; i < bindVertices.size(); ++i) {
+		bindRecorder->record(bindVertices[i], normals[i]);
+	}
+	for (auto& face : faces) {
+		bindRecorder->record_triangle(face[0], face[1], face[2]);
+	}
 }
 
 void Mesh::loadAttachments( const char* filename, int numJoints )
@@ -9,11 +9,17 @@
 #include <sstream>
 
 #include "tuple.h"
+#include "vertexrecorder.h"
 
 typedef tuple< unsigned, 3 > Tuple3u;
 
 struct Mesh
 {
+	Mesh() :
+		recorder(VA_POS_NORMAL, VU_STREAM),
+		flatRecorder(VA_POS, VU_STREAM),
+		smoothShading(false) {}
+
 	// list of vertices from the OBJ file
 	// in the "bind pose"
 	std::vector< Vector3f > bindVertices;
@@ -30,12 +36,31 @@ struct Mesh
 	// one attachment weight per joint
 	std::vector< std::vector< float > > attachments;
 
+	// GL buffers for draw(), kept between frames: positions and normals
+	// for smoothShading, positions only for the faceted look
+	VertexRecorder recorder;
+	VertexRecorder flatRecorder;
+
+	// By default the mesh is faceted, lit with the normal of each
+	// triangle (the flatShading uniform of c_fragmentshader_light).
+	// If set, draw() records smooth vertex normals instead.
+	bool smoothShading;
+
 	// 2.1.1. load() should populate bindVertices, currentVertices, and faces
 	void load(const char *filename);
 
-	// 2.1.2. draw the current mesh.
+	// 2.1.2. draw the current mesh. The flatShading uniform of the
+	// current program must be set to !smoothShading.
 	void draw();
 
+	// per-vertex normals of the faces with the given vertex positions,
+	// area weighted and not normalized
+	std::vector< Vector3f > computeNormals(const std::vector< Vector3f >& vertices) const;
+
+	// records the bind pose vertices, their normals and the faces,
+	// for skinning on the GPU
+	void recordBindPose(VertexRecorder* bindRecorder) const;
+
 	// 2.2. Implement this method to load the per-vertex attachment weights
 	// this method should update m_mesh.attachments
 	void loadAttachments( const char* filename, int numJoints );
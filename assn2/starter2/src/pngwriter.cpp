@@ -0,0 +1,109 @@
+#include "pngwriter.h"
+
+#include <lodepng.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Each call sets up its own LodePNGState, so frames can be encoded on
+// several threads at once.
+unsigned encodePng(const std::string& filename, const std::vector<uint8_t>& rgba,
+    int width, int height, PngEffort effort)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    LodePNGEncoderSettings& encoder = state.encoder;
+    // PNG filter type 2, each byte minus the one above it
+    std::vector<unsigned char> upFilters;
+    switch (effort) {
+    case PNG_FAST:
+        // Skip the colour analysis and the per-row filter search, and
+        // accept short matches from a small window. The Up filter costs
+        // little and suits rendered frames; no filter at all is barely
+        // faster and makes noisy frames several times larger.
+        upFilters.assign(height, 2);
+        encoder.auto_convert = 0;
+        encoder.filter_strategy = LFS_PREDEFINED;
+        encoder.predefined_filters = upFilters.data();
+        encoder.zlibsettings.windowsize = 512;
+        encoder.zlibsettings.nicematch = 32;
+        encoder.zlibsettings.lazymatching = 0;
+        break;
+    case PNG_DEFAULT:
+        break;
+    case PNG_SMALL:
+        encoder.filter_strategy = LFS_ENTROPY;
+        encoder.zlibsettings.windowsize = 32768;
+        encoder.zlibsettings.nicematch = 258;
+        break;
+    }
+
+    unsigned char* png = nullptr;
+    size_t pngsize = 0;
+    unsigned error = lodepng_encode(&png, &pngsize, rgba.data(), width, height, &state);
+    if (!error) {
+        error = lodepng_save_file(png, pngsize, filename.c_str());
+    }
+    free(png);
+    lodepng_state_cleanup(&state);
+    return error;
+}
+
+int encoderThreads(int threads)
+{
+    if (threads > 0) {
+        return threads;
+    }
+    int cores = (int)std::thread::hardware_concurrency();
+    return cores > 2 ? cores - 1 : 1;
+}
+
+}
+
+PngSequenceWriter::PngSequenceWriter(int threads, int maxQueued, PngEffort effort) :
+    m_effort(effort),
+    m_encoders(encoderThreads(threads),
+        maxQueued > 0 ? maxQueued : 2 * encoderThreads(threads))
+{
+}
+
+PngSequenceWriter::~PngSequenceWriter()
+{
+    m_encoders.wait();
+}
+
+void PngSequenceWriter::setEffort(PngEffort effort)
+{
+    m_effort = effort;
+}
+
+PngEffort PngSequenceWriter::effort() const
+{
+    return m_effort;
+}
+
+void PngSequenceWriter::write(const std::string& filename, std::vector<uint8_t> rgba,
+    int width, int height, bool report)
+{
+    // std::function needs a copyable job, so share the pixels instead
+    std::shared_ptr<std::vector<uint8_t> > image =
+        std::make_shared<std::vector<uint8_t> >(std::move(rgba));
+    PngEffort effort = m_effort;
+    m_encoders.submit([filename, image, width, height, effort, report]() {
+        unsigned error = encodePng(filename, *image, width, height, effort);
+        if (error) {
+            printf("Writing %s failed: %s\n", filename.c_str(), lodepng_error_text(error));
+        } else if (report) {
+            printf("Wrote %s\n", filename.c_str());
+        }
+    });
+}
+
+void PngSequenceWriter::wait()
+{
+    m_encoders.wait();
+}
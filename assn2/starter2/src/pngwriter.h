@@ -0,0 +1,56 @@
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "threadpool.h"
+
+// How hard lodepng tries to make the files small.
+enum PngEffort {
+    // one fixed row filter and a short zlib search; about twice as fast
+    // as PNG_DEFAULT for files a quarter larger, for recording animations
+    PNG_FAST,
+    // lodepng's own settings, as used by lodepng_encode32_file
+    PNG_DEFAULT,
+    // best filter per row and the full 32 KB zlib window; slow
+    PNG_SMALL
+};
+
+/* Encodes a sequence of RGBA images to PNG files on worker threads,
+   several frames at a time. At most maxQueued frames wait for a worker;
+   write() blocks while the queue is full, so a renderer producing
+   frames faster than they can be encoded is slowed down instead of
+   buffering every frame in memory.
+
+   write(), setEffort() and wait() must be called from one thread.
+*/
+class PngSequenceWriter {
+public:
+    // threads 0 uses all but one core, maxQueued 0 allows two frames
+    // per thread
+    explicit PngSequenceWriter(int threads = 0, int maxQueued = 0,
+        PngEffort effort = PNG_DEFAULT);
+    // writes the frames still queued
+    ~PngSequenceWriter();
+    PngSequenceWriter(const PngSequenceWriter&) = delete;
+    PngSequenceWriter& operator=(const PngSequenceWriter&) = delete;
+
+    // effort for the frames written from now on
+    void setEffort(PngEffort effort);
+    PngEffort effort() const;
+
+    // Queues width x height RGBA pixels, top row first, to be written
+    // to filename, waiting for room in the queue if it is full. With
+    // report, the file is printed once written; failures always are.
+    void write(const std::string& filename, std::vector<uint8_t> rgba,
+        int width, int height, bool report = false);
+    // waits until every queued frame has been written
+    void wait();
+
+private:
+    PngEffort m_effort;
+    ThreadPool m_encoders;
+};
+
+#endif
@@ -1,17 +1,30 @@
 #include "skeletalmodel.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "starter2_util.h"
 #include "vertexrecorder.h"
+#include "glstate.h"
 
 using namespace std;
 
-SkeletalModel::SkeletalModel() {
+SkeletalModel::SkeletalModel() :
+    m_jointSpheres(VA_POS_NORMAL, VU_STATIC, VU_STREAM),
+    m_boneCylinders(VA_POS_NORMAL, VU_STATIC, VU_STREAM),
+    m_gpuSkinning(false),
+    m_bindMesh(VA_POS_NORMAL),
+    m_jointBuffer(0),
+    m_attachmentBuffer(0),
+    m_attachmentTexture(0)
+{
     program = compileProgram(c_vertexshader, c_fragmentshader_light);
-    if (!program) {
+    if (!program.id) {
         printf("Cannot compile program\n");
         assert(false);
     }
+    recordSphere(0.025f, 12, 12, &m_jointSpheres);
+    recordCylinder(6, 0.02f, 1.0f, &m_boneCylinders);
 }
 
 SkeletalModel::~SkeletalModel() {
@@ -21,7 +34,13 @@ SkeletalModel::~SkeletalModel() {
         m_joints.pop_back();
     }
 
-    glDeleteProgram(program);
+    glDeleteProgram(program.id);
+    if (m_skinningProgram.id != 0) {
+        glDeleteProgram(m_skinningProgram.id);
+        glDeleteBuffers(1, &m_jointBuffer);
+        glDeleteTextures(1, &m_attachmentTexture);
+        glDeleteBuffers(1, &m_attachmentBuffer);
+    }
 }
 
 void SkeletalModel::load(const char *skeletonFile, const char *meshFile, const char *attachmentsFile)
@@ -42,43 +61,56 @@ void SkeletalModel::draw(const Camera& camera, bool skeletonVisible)
 
     m_matrixStack.clear();
 
-    glUseProgram(program);
-    updateShadingUniforms();
+    useProgram(program.id);
+    updateShadingUniforms(program);
     if (skeletonVisible)
     {
+        glUniform1i(program[U_FLATSHADING], GL_FALSE);
         drawJoints(camera);
         drawSkeleton(camera);
     }
+    else if (m_gpuSkinning)
+    {
+        // The mesh is skinned in the vertex shader,
+        // see setGpuSkinning()
+        bindGpuSkinning();
+        updateShadingUniforms(m_skinningProgram);
+        glUniform1i(m_skinningProgram[U_FLATSHADING], !m_mesh.smoothShading);
+        camera.SetUniforms(m_skinningProgram, Matrix4f::identity());
+        m_bindMesh.draw();
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
     else
     {
         // Tell the mesh to draw itself.
         // Since we transform mesh vertices on the CPU,
         // There is no need to set a Model matrix as uniform
         camera.SetUniforms(program, Matrix4f::identity());
+        glUniform1i(program[U_FLATSHADING], !m_mesh.smoothShading);
         m_mesh.draw();
     }
-    glUseProgram(0);
+    useProgram(0);
 }
 
-void SkeletalModel::updateShadingUniforms() {
+void SkeletalModel::updateShadingUniforms(const ShaderProgram& target) {
     // UPDATE MATERIAL UNIFORMS
     GLfloat diffColor[] = { 0.4f, 0.4f, 0.4f, 1 };
     GLfloat specColor[] = { 0.9f, 0.9f, 0.9f, 1 };
     GLfloat shininess[] = { 50.0f };
-    int loc = glGetUniformLocation(program, "diffColor");
+    int loc = target[U_DIFFCOLOR];
     glUniform4fv(loc, 1, diffColor);
-    loc = glGetUniformLocation(program, "specColor");
+    loc = target[U_SPECCOLOR];
     glUniform4fv(loc, 1, specColor);
-    loc = glGetUniformLocation(program, "shininess");
+    loc = target[U_SHININESS];
     glUniform1f(loc, shininess[0]);
 
     // UPDATE LIGHT UNIFORMS
     GLfloat lightPos[] = { 3.0f, 3.0f, 5.0f, 1.0f };
-    loc = glGetUniformLocation(program, "lightPos");
+    loc = target[U_LIGHTPOS];
     glUniform4fv(loc, 1, lightPos);
 
     GLfloat lightDiff[] = { 120.0f, 120.0f, 120.0f, 1.0f };
-    loc = glGetUniformLocation(program, "lightDiff");
+    loc = target[U_LIGHTDIFF];
     glUniform4fv(loc, 1, lightDiff);
 }
 
@@ -97,7 +129,7 @@ void SkeletalModel::loadSkeleton(const char* filename)
         lineStream >> x >> y >> z >> parentIndex;
 
         Joint *joint = new Joint;
-        joint->transform = Matrix4f::translation(x, y, z);
+        joint->transform = Affine3f::translation(x, y, z);
         m_joints.push_back(joint);
 
         if (parentIndex == -1) {
@@ -110,9 +142,7 @@ void SkeletalModel::loadSkeleton(const char* filename)
 
 void SkeletalModel::drawJoints_impl(const Camera& camera, const Joint * joint) {
     m_matrixStack.push(joint->transform);
-    camera.SetUniforms(program, m_matrixStack.top());
-
-    drawSphere(0.025f, 12, 12);
+    m_jointSpheres.record_instance(m_matrixStack.top().toMatrix4f());
 
     for (auto& child : joint->children) {
         drawJoints_impl(camera, child);
@@ -133,8 +163,13 @@ void SkeletalModel::drawJoints(const Camera& camera)
     // should push it's changes onto the stack, and
     // use stack.pop() to revert the stack to the original
     // state.
+    //
+    // The spheres are collected as instances and drawn in one call.
     m_matrixStack.clear();
+    m_jointSpheres.clear_instances();
     drawJoints_impl(camera, m_rootJoint);
+    camera.SetUniforms(program, Matrix4f::identity());
+    m_jointSpheres.draw_instanced(program);
 }
 
 void SkeletalModel::drawSkeleton_impl(const Camera& camera, const Joint * joint) {
@@ -142,10 +177,10 @@ void SkeletalModel::drawSkeleton_impl(const Camera& camera, const Joint * joint)
     
     // Traverse to children
     for (auto& child : joint->children) {
-        Vector3f childTranslation = child->transform.getCol(3).xyz();
+        Vector3f childTranslation = child->transform.getTranslation();
         float boneLength = childTranslation.abs();
 
-        Matrix4f cylinderTransform = Matrix4f::translation(childTranslation);
+        Affine3f cylinderTransform = Affine3f::translation(childTranslation);
 
         // Setup orthogonal coordinate system
         Vector3f y = -childTranslation.normalized();
@@ -156,10 +191,11 @@ void SkeletalModel::drawSkeleton_impl(const Camera& camera, const Joint * joint)
 
         // Setup transform
         Matrix3f cylinderRotation = Matrix3f(x, y, z);
-        cylinderTransform.setSubmatrix3x3(0, 0, cylinderRotation);
+        cylinderTransform.setLinear(cylinderRotation);
 
-        camera.SetUniforms(program, m_matrixStack.top() * cylinderTransform);
-        drawCylinder(6, 0.02f, boneLength);
+        // the unit cylinder is stretched to the bone length
+        m_boneCylinders.record_instance((m_matrixStack.top() * cylinderTransform).toMatrix4f()
+            * Matrix4f::scaling(1.0f, boneLength, 1.0f));
 
         drawSkeleton_impl(camera, child);
     }
@@ -177,22 +213,24 @@ void SkeletalModel::drawSkeleton(const Camera& camera)
 
 
     m_matrixStack.clear();
+    m_boneCylinders.clear_instances();
     drawSkeleton_impl(camera, m_rootJoint);
+    camera.SetUniforms(program, Matrix4f::identity());
+    m_boneCylinders.draw_instanced(program);
 }
 
 void SkeletalModel::setJointTransform(int jointIndex, float rX, float rY, float rZ)
 {
     // Set the rotation part of the joint's transformation matrix based on the passed in Euler angles.
-    m_joints[jointIndex]->transform.setSubmatrix3x3(
-        0,
-        0,
+    m_joints[jointIndex]->transform.setLinear(
         Matrix3f::rotateX(rX) * Matrix3f::rotateY(rY) * Matrix3f::rotateZ(rZ)
     );
 }
 
 void SkeletalModel::computeBindWorldToJointTransforms_impl(Joint * joint) {
     m_matrixStack.push(joint->transform);
-    joint->bindWorldToJointTransform = m_matrixStack.top().inverse();
+    // joint transforms are translations and rotations only
+    joint->bindWorldToJointTransform = m_matrixStack.top().inverseRigid();
     for (auto& child : joint->children) {
         computeBindWorldToJointTransforms_impl(child);
     }
@@ -245,16 +283,184 @@ void SkeletalModel::updateMesh()
     // given the current state of the skeleton.
     // You will need both the bind pose world --> joint transforms.
     // and the current joint --> world transforms.
-    for (size_t i = 0; i < m_mesh.bindVertices.size(); ++i) {
-        Vector4f bindVertex4f = Vector4f(m_mesh.bindVertices[i], 1.0);
-
-        // Vector4f newCurrentVertex4f = Vector4f(0.0f, 0.0f, 0.0f, 0.0f);
-        Vector3f newCurrentVertex = Vector3f(0.0f, 0.0f, 0.0f);
-        for (size_t j = 0; j < m_joints.size(); ++j) {
-            float weight = m_mesh.attachments[i][j];
-            newCurrentVertex += weight * (m_joints[j]->currentJointToWorldTransform * m_joints[j]->bindWorldToJointTransform * bindVertex4f).xyz();
+    //
+    // Joints are processed one at a time: each joint's bind pose --> current
+    // pose transform is computed once and applied to the whole mesh, weighted
+    // by that joint's attachments.
+    int numVertices = (int)m_mesh.bindVertices.size();
+    std::fill(m_mesh.currentVertices.begin(), m_mesh.currentVertices.end(), Vector3f(0.0f, 0.0f, 0.0f));
+
+    vector<float> weights(numVertices);
+    for (size_t j = 0; j < m_joints.size(); ++j) {
+        for (int i = 0; i < numVertices; ++i) {
+            weights[i] = m_mesh.attachments[i][j];
+        }
+
+        Matrix4f bindToCurrent = (m_joints[j]->currentJointToWorldTransform * m_joints[j]->bindWorldToJointTransform).toMatrix4f();
+        bindToCurrent.accumulateTransformedPoints(m_mesh.bindVertices.data(), weights.data(), m_mesh.currentVertices.data(), numVertices);
+    }
+}
+
+bool SkeletalModel::setGpuSkinning(bool enabled)
+{
+    if (enabled && !initGpuSkinning()) {
+        return false;
+    }
+    if (m_gpuSkinning && !enabled) {
+        // the CPU vertices were not updated while skinning on the GPU
+        updateMesh();
+    }
+    m_gpuSkinning = enabled;
+    return true;
+}
+
+bool SkeletalModel::gpuSkinning() const
+{
+    return m_gpuSkinning;
+}
+
+int SkeletalModel::jointCount() const
+{
+    return (int)m_joints.size();
+}
+
+void SkeletalModel::setSmoothShading(bool enabled)
+{
+    m_mesh.smoothShading = enabled;
+}
+
+bool SkeletalModel::smoothShading() const
+{
+    return m_mesh.smoothShading;
+}
+
+/* The attachments go into a buffer texture rather than vertex attributes,
+   so every vertex keeps all of its weights, as in updateMesh(), instead
+   of only the few largest. The shader finds a vertex's weights with
+   gl_VertexID, four per RGBA texel.
+*/
+bool SkeletalModel::initGpuSkinning()
+{
+    if (m_skinningProgram.id != 0) {
+        return true;
+    }
+    int numJoints = (int)m_joints.size();
+    if (numJoints > MAX_SKIN_JOINTS) {
+        printf("GPU skinning supports at most %d joints\n", MAX_SKIN_JOINTS);
+        return false;
+    }
+    size_t numVertices = m_mesh.bindVertices.size();
+    size_t texels = (numJoints + 3) / 4;
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    if (numVertices * texels > (size_t)maxTexels) {
+        printf("Too many vertices for GPU skinning\n");
+        return false;
+    }
+    m_skinningProgram = compileProgram(c_vertexshader_skinned, c_fragmentshader_light, "var_Position");
+    if (!m_skinningProgram.id) {
+        printf("Cannot compile program\n");
+        return false;
+    }
+
+    m_mesh.recordBindPose(&m_bindMesh);
+
+    std::vector<float> weights(numVertices * texels * 4, 0.0f);
+    for (size_t i = 0; i < numVertices; ++i) {
+        for (int j = 0; j < numJoints; ++j) {
+            weights[i * texels * 4 + j] = m_mesh.attachments[i][j];
         }
-        
-        m_mesh.currentVertices[i] = newCurrentVertex;
     }
-}
\ No newline at end of file
+    glGenBuffers(1, &m_attachmentBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_attachmentBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, weights.size() * sizeof(float), weights.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glGenTextures(1, &m_attachmentTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, m_attachmentTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_attachmentBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    glGenBuffers(1, &m_jointBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_jointBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, MAX_SKIN_JOINTS * 16 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return true;
+}
+
+// Only the joint transforms change between frames, 64 bytes per joint.
+void SkeletalModel::bindGpuSkinning()
+{
+    // bind pose --> current pose, the transform updateMesh() applies
+    std::vector<float> transforms(m_joints.size() * 16);
+    for (size_t j = 0; j < m_joints.size(); ++j) {
+        Matrix4f bindToCurrent = (m_joints[j]->currentJointToWorldTransform * m_joints[j]->bindWorldToJointTransform).toMatrix4f();
+        memcpy(&transforms[j * 16], (const float*)bindToCurrent, 16 * sizeof(float));
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, m_jointBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, transforms.size() * sizeof(float), transforms.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, JOINT_BLOCK_BINDING, m_jointBuffer);
+
+    useProgram(m_skinningProgram.id);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, m_attachmentTexture);
+    glUniform1i(m_skinningProgram[U_ATTACHMENTS], 0);
+    glUniform1i(m_skinningProgram[U_JOINTCOUNT], (int)m_joints.size());
+}
+
+/* The mesh is drawn with rasterization off while transform feedback
+   captures var_Position, which is the skinned vertex since M is the
+   identity. Each triangle corner is captured, so every vertex is
+   compared once per face it belongs to. Works headless, e.g. on a
+   software GL driver.
+*/
+float SkeletalModel::compareGpuSkinning()
+{
+    if (!initGpuSkinning()) {
+        return -1.0f;
+    }
+    updateMesh();
+
+    const std::vector<Tuple3u>& faces = m_mesh.faces;
+    size_t nbytes = faces.size() * 3 * 3 * sizeof(float);
+    GLuint feedback;
+    glGenBuffers(1, &feedback);
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+    glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, nbytes, nullptr, GL_STREAM_READ);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+
+    bindGpuSkinning();
+    Matrix4f identity = Matrix4f::identity();
+    glUniformMatrix4fv(m_skinningProgram[U_M], 1, GL_FALSE, identity);
+    glUniformMatrix4fv(m_skinningProgram[U_N], 1, GL_FALSE, identity);
+    setEnabled(GL_RASTERIZER_DISCARD, true);
+    glBeginTransformFeedback(GL_TRIANGLES);
+    m_bindMesh.draw();
+    glEndTransformFeedback();
+    setEnabled(GL_RASTERIZER_DISCARD, false);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    useProgram(0);
+
+    float maxError = 0.0f;
+    const float* skinned = (const float*)glMapBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0, nbytes, GL_MAP_READ_BIT);
+    if (skinned != nullptr) {
+        for (size_t f = 0; f < faces.size(); ++f) {
+            for (int k = 0; k < 3; ++k) {
+                const float* p = skinned + 3 * (3 * f + k);
+                Vector3f error = Vector3f(p[0], p[1], p[2]) - m_mesh.currentVertices[faces[f][k]];
+                maxError = std::max(maxError, error.abs());
+            }
+        }
+        // false if the buffer was corrupted while mapped
+        if (!glUnmapBuffer(GL_TRANSFORM_FEEDBACK_BUFFER)) {
+            skinned = nullptr;
+        }
+    }
+    if (skinned == nullptr) {
+        printf("Reading back the GPU skinned vertices failed\n");
+        maxError = -1.0f;
+    }
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+    glDeleteBuffers(1, &feedback);
+    return maxError;
+}
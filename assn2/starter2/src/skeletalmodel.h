@@ -16,6 +16,7 @@
 #include "mesh.h"
 #include "matrixstack.h"
 #include "camera.h"
+#include "starter2_util.h"
 
 class SkeletalModel
 {
@@ -25,7 +26,8 @@ public:
     // Already-implemented utility functions that call the code you will write.
     void load(const char *skeletonFile, const char *meshFile, const char *attachmentsFile);
     void draw(const Camera& camera, bool drawSkeleton);
-    void updateShadingUniforms();
+    // sets the material and light uniforms of target, the current program
+    void updateShadingUniforms(const ShaderProgram& target);
 
     // Part 1: Understanding Hierarchical Modeling
 
@@ -44,6 +46,7 @@ public:
     // 1.3. Implement this method to handle changes to your skeleton given
     // changes in the slider values
     void setJointTransform(int jointIndex, float rX, float rY, float rZ);
+    int jointCount() const;
 
     // Part 2: Skeletal Subspace Deformation
 
@@ -66,14 +69,52 @@ public:
     // and the current joint --> world transforms.
     void updateMesh();
 
+    // GPU skinning
+
+    // Skins the mesh in the vertex shader (c_vertexshader_skinned) instead
+    // of in updateMesh(): the bind pose and the attachments are uploaded
+    // once and draw() only sends the joint transforms. Returns false and
+    // keeps skinning on the CPU if the GL limits are too small.
+    bool setGpuSkinning(bool enabled);
+    bool gpuSkinning() const;
+
+    // The mesh is faceted unless smooth shading is on, see Mesh::smoothShading.
+    void setSmoothShading(bool enabled);
+    bool smoothShading() const;
+
+    // Largest distance between the vertices skinned on the GPU, read back
+    // with transform feedback, and the ones computed by updateMesh().
+    // Returns -1 if GPU skinning is not available or the readback fails.
+    // Run headless by a2_skinning_check, see skinningcheck.cpp.
+    float compareGpuSkinning();
+
 private:
+    // creates the GL objects for GPU skinning on first use
+    bool initGpuSkinning();
+    // makes the skinning program current, with the current joint
+    // transforms and the attachments bound
+    void bindGpuSkinning();
+
     // pointer to the root joint
     Joint* m_rootJoint;
     // the list of joints.
     std::vector< Joint* > m_joints;
     Mesh m_mesh;
     MatrixStack m_matrixStack;
-    GLuint program;
+    ShaderProgram program;
+
+    // one sphere and one unit height cylinder, drawn instanced at
+    // every joint and bone
+    VertexRecorder m_jointSpheres;
+    VertexRecorder m_boneCylinders;
+
+    // GPU skinning, see setGpuSkinning()
+    bool m_gpuSkinning;
+    ShaderProgram m_skinningProgram;
+    VertexRecorder m_bindMesh; // bind pose vertices, normals and faces
+    uint32_t m_jointBuffer; // uniform buffer for JointBlock
+    uint32_t m_attachmentBuffer; // the attachments, read through
+    uint32_t m_attachmentTexture; // a buffer texture
 };
 
 #endif
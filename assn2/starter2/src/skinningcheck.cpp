@@ -0,0 +1,173 @@
+// Headless check of GPU skinning: loads a model, poses it and compares
+// the vertices skinned in the vertex shader with the ones computed by
+// SkeletalModel::updateMesh(), see SkeletalModel::compareGpuSkinning().
+//
+// The GL context comes from EGL without a window or a display, so the
+// check runs on a software driver such as Mesa's llvmpipe, e.g. in CI.
+// Exits with 0 if every pose is within the tolerance, 1 otherwise.
+//
+// Usage: a2_skinning_check PREFIX [TOLERANCE]
+
+#include "gl.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "skeletalmodel.h"
+#include "streambuffer.h"
+#include "vertexrecorder.h"
+
+namespace {
+
+// a 3.3 core context made current on a 1x1 pbuffer
+struct HeadlessContext {
+    EGLDisplay display;
+    EGLSurface surface;
+    EGLContext context;
+};
+
+bool createContext(HeadlessContext* ctx)
+{
+    // Mesa's surfaceless platform needs no X server; other drivers
+    // provide a default display that can make pbuffers
+    ctx->display = EGL_NO_DISPLAY;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+        ctx->display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (ctx->display == EGL_NO_DISPLAY) {
+        ctx->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    if (ctx->display == EGL_NO_DISPLAY || !eglInitialize(ctx->display, nullptr, nullptr)) {
+        printf("Cannot initialize EGL\n");
+        return false;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint nconfigs = 0;
+    if (!eglChooseConfig(ctx->display, configAttribs, &config, 1, &nconfigs) || nconfigs == 0) {
+        printf("No EGL config for desktop OpenGL\n");
+        return false;
+    }
+    const EGLint surfaceAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    ctx->surface = eglCreatePbufferSurface(ctx->display, config, surfaceAttribs);
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+        EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+    ctx->context = eglCreateContext(ctx->display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (ctx->surface == EGL_NO_SURFACE || ctx->context == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(ctx->display, ctx->surface, ctx->surface, ctx->context)) {
+        printf("Cannot create an OpenGL 3.3 context with EGL\n");
+        return false;
+    }
+
+    // glew.c is built with GLEW_EGL for this program
+    if (glewInit() != GLEW_OK) {
+        printf("Cannot initialize GLEW\n");
+        return false;
+    }
+    printf("Running on %s, OpenGL %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    return true;
+}
+
+void destroyContext(HeadlessContext* ctx)
+{
+    eglMakeCurrent(ctx->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(ctx->display, ctx->context);
+    eglDestroySurface(ctx->display, ctx->surface);
+    eglTerminate(ctx->display);
+}
+
+// Sets every joint to a rotation that depends on the joint and the pose;
+// pose 0 is the bind pose.
+void setPose(SkeletalModel* skeleton, int pose)
+{
+    for (int j = 0; j < skeleton->jointCount(); ++j) {
+        float a = 0.4f * pose;
+        skeleton->setJointTransform(j, a * sinf(j + 1.0f), a * cosf(2.0f * j), a * sinf(3.0f * j + 2.0f));
+    }
+    skeleton->updateCurrentJointToWorldTransforms();
+}
+
+// checks each pose and returns the number over the tolerance, or -1 if
+// GPU skinning is not available
+int checkPoses(SkeletalModel* skeleton, float tolerance)
+{
+    const int NPOSES = 4;
+    int failed = 0;
+    for (int pose = 0; pose < NPOSES; ++pose) {
+        setPose(skeleton, pose);
+        float error = skeleton->compareGpuSkinning();
+        if (error < 0) {
+            return -1;
+        }
+        bool ok = error <= tolerance;
+        printf("pose %d: GPU - CPU skinning difference %g %s\n", pose, error, ok ? "ok" : "FAILED");
+        if (!ok) {
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        printf("Usage: %s PREFIX [TOLERANCE]\n", argv[0]);
+        printf("For example: %s data/Model1 1e-4\n", argv[0]);
+        return 1;
+    }
+    std::string basepath = argv[1];
+    float tolerance = argc > 2 ? (float)atof(argv[2]) : 1e-4f;
+    std::string skelfile = basepath + ".skel";
+    std::string objfile = basepath + ".obj";
+    std::string attachfile = basepath + ".attach";
+    // the loaders do not check for missing files
+    for (const std::string& file : { skelfile, objfile, attachfile }) {
+        if (!std::ifstream(file.c_str())) {
+            printf("Cannot open %s\n", file.c_str());
+            return 1;
+        }
+    }
+
+    HeadlessContext ctx;
+    if (!createContext(&ctx)) {
+        return 1;
+    }
+
+    int failed;
+    {
+        SkeletalModel skeleton;
+        skeleton.load(skelfile.c_str(), objfile.c_str(), attachfile.c_str());
+        failed = checkPoses(&skeleton, tolerance);
+    }
+    freePrimitives();
+    freeFrameStream();
+    destroyContext(&ctx);
+
+    if (failed < 0) {
+        printf("GPU skinning is not available\n");
+        return 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
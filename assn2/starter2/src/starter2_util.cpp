@@ -2,11 +2,9 @@
 
 #include "gl.h"
 #include <GLFW/glfw3.h>
-#include <lodepng.h>
 
 #include <cstdio>
 #include <cstring>
-#include <ctime>
 #include <cassert>
 
 
@@ -141,14 +139,75 @@ static bool linkProgram(GLuint handle, GLuint vshader, GLuint fshader)
 	return true;
 }
 
-uint32_t compileProgram(const char* vshader_src, const char* fshader_src)
+// names of the Uniform values, in order
+static const char* c_uniformNames[U_COUNT] = {
+	"M",
+	"N",
+	"diffColor",
+	"specColor",
+	"shininess",
+	"lightPos",
+	"lightDiff",
+	"instanced",
+	"attachments",
+	"jointCount",
+	"flatShading",
+};
+
+ShaderProgram::ShaderProgram() :
+	id(0)
 {
-	GLuint program = glCreateProgram();
+	for (int u = 0; u < U_COUNT; ++u) {
+		location[u] = -1;
+	}
+}
+
+// Looks up the locations of the active uniforms of a linked program.
+// Uniforms that are declared but unused are not active and keep
+// location -1, which the glUniform functions ignore.
+static void resolveUniforms(ShaderProgram* program)
+{
+	int count = 0;
+	glGetProgramiv(program->id, GL_ACTIVE_UNIFORMS, &count);
+	for (int i = 0; i < count; ++i) {
+		char name[256];
+		GLsizei length;
+		GLint size;
+		GLenum type;
+		glGetActiveUniform(program->id, i, sizeof(name), &length, &size, &type, name);
+		for (int u = 0; u < U_COUNT; ++u) {
+			if (strcmp(name, c_uniformNames[u]) == 0) {
+				program->location[u] = glGetUniformLocation(program->id, name);
+				break;
+			}
+		}
+	}
+}
+
+ShaderProgram compileProgram(const char* vshader_src, const char* fshader_src,
+	const char* feedbackVarying)
+{
+	ShaderProgram program;
+	program.id = glCreateProgram();
 	GLuint vshader = compileShader(GL_VERTEX_SHADER, vshader_src);
 	GLuint fshader = compileShader(GL_FRAGMENT_SHADER, fshader_src);
-	if (!linkProgram(program, vshader, fshader)) {
-		glDeleteProgram(program);
-		program = 0;
+	if (feedbackVarying) {
+		// must be set before linking
+		glTransformFeedbackVaryings(program.id, 1, &feedbackVarying, GL_INTERLEAVED_ATTRIBS);
+	}
+	if (linkProgram(program.id, vshader, fshader)) {
+		resolveUniforms(&program);
+		GLuint block = glGetUniformBlockIndex(program.id, "CameraBlock");
+		if (block != GL_INVALID_INDEX) {
+			glUniformBlockBinding(program.id, block, CAMERA_BLOCK_BINDING);
+		}
+		block = glGetUniformBlockIndex(program.id, "JointBlock");
+		if (block != GL_INVALID_INDEX) {
+			glUniformBlockBinding(program.id, block, JOINT_BLOCK_BINDING);
+		}
+	} else {
+		glDeleteProgram(program.id);
+		program.id = 0;
 	}
 	// once a program is linked
 	// shader objects should be deleted
@@ -175,34 +234,3 @@ float rad2deg(float rad)
 {
 	return rad / 3.141592f * 180.0f;
 }
-
-void screencapture(GLFWwindow* window) {
-    int w, h;
-    glfwGetFramebufferSize(window, &w, &h);
-
-    std::vector<uint8_t> buff(w * h * 4);
-    glReadBuffer(GL_BACK);
-
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glPixelStorei(GL_PACK_ROW_LENGTH, w);
-
-    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, buff.data());
-    // glReadPixels reads upside-down
-    for (int srcy = 0; srcy < h / 2; ++srcy) {
-        int dsty = (h - 1 - srcy);
-        for (int x = 0; x < w * 4; ++x) {
-            std::swap(buff[srcy*w * 4 + x], buff[dsty*w * 4 + x]);
-        }
-    }
-
-    char fname[80];
-    sprintf(fname, "out_%lu.png", (unsigned long)time(nullptr));
-
-    if (lodepng_encode32_file(fname, buff.data(), w, h)) {
-        printf("Writing screenshot failed\n");
-    }
-    else {
-        printf("Wrote screenshot to %s\n", fname);
-    }
-}
-
@@ -11,13 +11,47 @@ struct GLFWwindow;
 // creates a window using GLFW and initializes an OpenGL 3.3+ context.
 GLFWwindow* createOpenGLWindow(int width, int height, const char* title);
 
-// returns 0 on error
-// program must be freed with glDeleteProgram()
-uint32_t compileProgram(const char* vertexshader, const char* fragmentshader);
-
-struct GLFWwindow;
-// write a screenshot to the currenct working directory
-void screencapture(GLFWwindow* window);
+// Uniform buffer binding of CameraBlock, which compileProgram() assigns
+// to every program. Binding 0 is left to nanovg, which draws the GUI.
+const uint32_t CAMERA_BLOCK_BINDING = 1;
+// Uniform buffer binding of JointBlock (c_vertexshader_skinned).
+const uint32_t JOINT_BLOCK_BINDING = 2;
+// Size of the joints array in JointBlock.
+const int MAX_SKIN_JOINTS = 64;
+
+// Uniforms of the shaders below, except the ones in CameraBlock.
+enum Uniform {
+    U_M,
+    U_N,
+    U_DIFFCOLOR,
+    U_SPECCOLOR,
+    U_SHININESS,
+    U_LIGHTPOS,
+    U_LIGHTDIFF,
+    U_INSTANCED,
+    U_ATTACHMENTS,
+    U_JOINTCOUNT,
+    U_FLATSHADING,
+    U_COUNT
+};
+
+// A linked program together with the locations of its uniforms,
+// which are looked up once when the program is compiled.
+struct ShaderProgram {
+    ShaderProgram();
+
+    uint32_t id;
+    // location of each Uniform, -1 if the program does not use it
+    int location[U_COUNT];
+
+    int operator[](Uniform u) const { return location[u]; }
+};
+
+// returns a program with id 0 on error
+// program.id must be freed with glDeleteProgram()
+// feedbackVarying, if given, is captured by transform feedback
+ShaderProgram compileProgram(const char* vertexshader, const char* fragmentshader,
+    const char* feedbackVarying = nullptr);
 
 static const char* c_vertexshader = R"RAWSTR(
 #version 330
@@ -28,11 +62,21 @@ layout(location=0) in vec3 Position;
 layout(location=1) in vec3 Normal;
 layout(location=2) in vec3 Color;
 
-uniform mat4 P;
-uniform mat4 V;
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
 uniform mat4 M;
 uniform mat4 N;
 
+// Per-instance model matrix and color, read when instanced is set,
+// see VertexRecorder::draw_instanced().
+layout(location=3) in vec4 InstanceColor;
+layout(location=4) in mat4 InstanceM;
+uniform bool instanced;
+
 // var_ (varying) variables are output in the vertex
 // shader and are interpolated by the GPU for each
 // pixel of the triangle.
@@ -41,14 +85,77 @@ out vec3 var_Normal;
 out vec4 var_Color;
 
 void main () {
+    // instances apply their model matrix before M
+    mat4 model = M;
+    mat3 normal_instance = mat3(1);
+    var_Color = vec4(Color, 1);
+    if (instanced) {
+        model = M * InstanceM;
+        normal_instance = transpose(inverse(mat3(InstanceM)));
+        var_Color = InstanceColor;
+    }
+
     // Simple pass-through vertex shader
-    vec4 position_world = M * vec4(Position, 1);
-    gl_Position = P * V * M * vec4(Position, 1);
+    vec4 position_world = model * vec4(Position, 1);
+    gl_Position = P * V * position_world;
     var_Position = position_world.xyz / position_world.w;
 
-    vec3 normal_world = (N * vec4(Normal, 1)).xyz;
+    vec3 normal_world = (N * vec4(normal_instance * Normal, 1)).xyz;
     var_Normal = normalize(normal_world);
-    var_Color = vec4(Color, 1);
+}
+)RAWSTR";
+// Linear blend skinning on the GPU, see SkeletalModel::setGpuSkinning().
+// Position and Normal are in the bind pose; each vertex is moved by the
+// joint transforms weighted by its attachments, as SkeletalModel::updateMesh()
+// does on the CPU. Takes the place of c_vertexshader for the mesh.
+static const char* c_vertexshader_skinned = R"RAWSTR(
+#version 330
+layout(location=0) in vec3 Position;
+layout(location=1) in vec3 Normal;
+
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
+uniform mat4 M;
+uniform mat4 N;
+
+// bind pose --> current pose transform of every joint,
+// MAX_SKIN_JOINTS entries
+layout(std140) uniform JointBlock {
+    mat4 joints[64];
+};
+// attachment weights, jointCount per vertex packed four to a texel
+uniform samplerBuffer attachments;
+uniform int jointCount;
+
+out vec3 var_Position;
+out vec3 var_Normal;
+out vec4 var_Color;
+
+void main () {
+    vec3 position = vec3(0);
+    vec3 normal = vec3(0);
+    int texels = (jointCount + 3) / 4;
+    for (int t = 0; t < texels; ++t) {
+        vec4 w = texelFetch(attachments, gl_VertexID * texels + t);
+        for (int k = 0; k < 4; ++k) {
+            int j = 4 * t + k;
+            if (w[k] != 0.0 && j < jointCount) {
+                position += w[k] * (joints[j] * vec4(Position, 1)).xyz;
+                // joint transforms are rigid
+                normal += w[k] * (mat3(joints[j]) * Normal);
+            }
+        }
+    }
+
+    vec4 position_world = M * vec4(position, 1);
+    gl_Position = P * V * position_world;
+    var_Position = position_world.xyz / position_world.w;
+    var_Normal = normalize((N * vec4(normal, 1)).xyz);
+    var_Color = vec4(1);
 }
 )RAWSTR";
 static const char* c_fragmentshader_color = R"RAWSTR(
@@ -70,11 +177,19 @@ in vec4 var_Color;
 in vec3 var_Normal;
 in vec3 var_Position;
 
-uniform vec3 camPos;
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
 
 uniform vec4 diffColor;
 uniform vec4 specColor;
 uniform float shininess;
+uniform bool instanced;
+// light with the normal of the triangle instead of var_Normal
+uniform bool flatShading;
 
 uniform vec4 lightPos;
 uniform vec4 lightDiff;
@@ -84,12 +199,21 @@ layout(location=0) out vec4 out_Color;
 // shaders can have #defines, too
 #define PI_INV 0.318309886183791
 
+// The normal of the triangle being drawn: the screen space derivatives
+// of the position span its plane. Their cross product faces the viewer,
+// so it is flipped for back faces to point the way the triangle winds.
+vec3 face_normal() {
+    vec3 n = normalize(cross(dFdx(var_Position), dFdy(var_Position)));
+    return gl_FrontFacing ? n : -n;
+}
+
 vec4 blinn_phong() {
     // Implement Blinn-Phong Shading Model
     // 1. Convert everything to world space
     //    and normalize directions
     vec4 pos_world = vec4(var_Position, 1);
-    vec3 normal_world = normalize(var_Normal);
+    vec3 normal_flat = face_normal();
+    vec3 normal_world = flatShading ? normal_flat : normalize(var_Normal);
     pos_world /= pos_world.w;
     vec3 light_dir = (lightPos - pos_world).xyz;
     vec3 cam_dir = camPos - pos_world.xyz;
@@ -98,8 +222,10 @@ vec4 blinn_phong() {
     cam_dir = normalize(cam_dir);
 
     // 2. Compute Diffuse Contribution
+    // (instances tint the diffuse color with their own color)
+    vec3 kd = instanced ? diffColor.xyz * var_Color.rgb : diffColor.xyz;
     float ndotl = max(dot(normal_world, light_dir), 0.0);
-    vec3 diffContrib = PI_INV * lightDiff.xyz * diffColor.xyz
+    vec3 diffContrib = PI_INV * lightDiff.xyz * kd
                        * ndotl / distsq;
 
     // 3. Compute Specular Contribution
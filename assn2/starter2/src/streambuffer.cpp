@@ -0,0 +1,163 @@
+#include "streambuffer.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// writes start on a multiple of this, which keeps every vertex and
+// instance attribute aligned
+static const size_t STREAM_ALIGNMENT = 64;
+// enough for three frames of the largest meshes in the assignments
+static const size_t FRAME_STREAM_SIZE = 8 << 20;
+// glClientWaitSync takes nanoseconds
+static const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+StreamBuffer::StreamBuffer(size_t size) :
+    m_size(size),
+    m_head(0),
+    m_framebegin(0),
+    m_frame(0),
+    m_buffer(0)
+{
+    assert(size > 0);
+}
+
+// The GL context that was current in write() must still be current here.
+StreamBuffer::~StreamBuffer()
+{
+    for (const Range& range : m_pending) {
+        glDeleteSync(range.fence);
+    }
+    if (m_buffer != 0) {
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+/* The buffer is mapped with GL_MAP_UNSYNCHRONIZED_BIT, which tells the
+   driver not to wait for draws still reading the buffer. That is only
+   safe because reclaim() has waited for the fence of every range that
+   overlaps the one written. The copy-write binding is used so that the
+   array and element buffer bindings of the caller are left alone.
+*/
+size_t StreamBuffer::write(const void* data, size_t nbytes)
+{
+    assert(nbytes <= m_size);
+    if (m_buffer == 0) {
+        glGenBuffers(1, &m_buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, m_size, nullptr, GL_STREAM_DRAW);
+    } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    }
+
+    size_t offset = (m_head + STREAM_ALIGNMENT - 1) & ~(STREAM_ALIGNMENT - 1);
+    if (offset + nbytes > m_size) {
+        // wrap around. The data of this frame so far is fenced as its own
+        // range, so the ranges in m_pending never wrap themselves, and the
+        // unfenced range starts again at 0.
+        fence();
+        m_framebegin = 0;
+        offset = 0;
+    }
+    reclaim(offset, offset + nbytes);
+
+    if (nbytes > 0) {
+        void* dst = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, nbytes,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        memcpy(dst, data, nbytes);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_head = offset + nbytes;
+    return offset;
+}
+
+void StreamBuffer::endFrame()
+{
+    fence();
+    ++m_frame;
+}
+
+void StreamBuffer::fence()
+{
+    // write() restarts the range when it wraps, so it never ends before
+    // it begins
+    assert(m_head >= m_framebegin);
+    if (m_head > m_framebegin) {
+        Range range = { m_framebegin, m_head,
+            glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) };
+        m_pending.push_back(range);
+    }
+    m_framebegin = m_head;
+}
+
+// The GPU finishes commands in order, so waiting for the newest
+// overlapping range also releases every range fenced before it.
+void StreamBuffer::reclaim(size_t begin, size_t end)
+{
+    size_t last = m_pending.size();
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        if (m_pending[i].begin < end && begin < m_pending[i].end) {
+            last = i;
+        }
+    }
+    if (last == m_pending.size()) {
+        return;
+    }
+    // only stalls when the ring is too small for the frames in flight.
+    // The range must not be written before the GPU is done with it, so
+    // a timeout only means waiting again.
+    GLenum status;
+    do {
+        status = glClientWaitSync(m_pending[last].fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+    } while (status == GL_TIMEOUT_EXPIRED);
+    if (status == GL_WAIT_FAILED) {
+        // the fence is unusable; wait for all GL commands instead
+        printf("Waiting for a stream buffer fence failed\n");
+        glFinish();
+    }
+    for (size_t i = 0; i <= last; ++i) {
+        glDeleteSync(m_pending.front().fence);
+        m_pending.pop_front();
+    }
+}
+
+uint32_t StreamBuffer::buffer() const
+{
+    return m_buffer;
+}
+
+size_t StreamBuffer::size() const
+{
+    return m_size;
+}
+
+uint64_t StreamBuffer::frame() const
+{
+    return m_frame;
+}
+
+// Created on first use like the primitive meshes, so that no GL call is
+// made before the context exists.
+static StreamBuffer* s_frameStream = nullptr;
+
+StreamBuffer& frameStream()
+{
+    if (s_frameStream == nullptr) {
+        s_frameStream = new StreamBuffer(FRAME_STREAM_SIZE);
+    }
+    return *s_frameStream;
+}
+
+void endStreamFrame()
+{
+    if (s_frameStream != nullptr) {
+        s_frameStream->endFrame();
+    }
+}
+
+void freeFrameStream()
+{
+    delete s_frameStream;
+    s_frameStream = nullptr;
+}
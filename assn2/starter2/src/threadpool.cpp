@@ -0,0 +1,70 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(int threads, size_t maxQueued) :
+    m_maxQueued(maxQueued),
+    m_active(0),
+    m_stopping(false)
+{
+    if (threads < 1) {
+        threads = 1;
+    }
+    for (int i = 0; i < threads; ++i) {
+        m_threads.push_back(std::thread(&ThreadPool::run, this));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobQueued.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_maxQueued != 0) {
+            m_jobTaken.wait(lock, [this]() { return m_jobs.size() < m_maxQueued; });
+        }
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobQueued.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this]() { return m_jobs.empty() && m_active == 0; });
+}
+
+// Workers only exit once the queue is empty, so the destructor
+// finishes every job that was submitted.
+void ThreadPool::run()
+{
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobQueued.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            ++m_active;
+        }
+        m_jobTaken.notify_one();
+        job();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active;
+        }
+        m_jobDone.notify_all();
+    }
+}
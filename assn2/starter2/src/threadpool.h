@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that run submitted jobs in the order
+// they were submitted. Used to keep slow CPU work, like PNG encoding,
+// off the render thread.
+class ThreadPool {
+public:
+    // starts the worker threads, at least one. If maxQueued is not 0, at
+    // most that many jobs wait for a worker and submit() blocks while
+    // the queue is full.
+    explicit ThreadPool(int threads, size_t maxQueued = 0);
+    // runs the jobs still queued, then joins the workers
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // queues job to run on one of the workers, waiting for room in the
+    // queue first if it is bounded
+    void submit(std::function<void()> job);
+    // blocks until every submitted job has finished
+    void wait();
+
+private:
+    // worker thread main loop
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()> > m_jobs;
+    std::mutex m_mutex; // guards everything below
+    std::condition_variable m_jobQueued;
+    std::condition_variable m_jobTaken;
+    std::condition_variable m_jobDone;
+    size_t m_maxQueued; // 0 for no limit
+    int m_active; // jobs taken off the queue and not finished yet
+    bool m_stopping;
+};
+
+#endif
@@ -2,14 +2,54 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <utility>
 #include "gl.h"
+#include "streambuffer.h"
+#include "starter2_util.h"
 
 #ifndef M_PIf
 #define M_PIf 3.141592f
 #endif
 
-VertexRecorder::VertexRecorder() :m_nverts(0)
+VertexRecorder::VertexRecorder(int attribs, VertexUsage usage, VertexUsage instanceUsage) :
+    m_attribs(attribs),
+    m_usage(usage),
+    m_instanceusage(instanceUsage),
+    m_stride(0),
+    m_nverts(0),
+    m_vertexarray(0),
+    m_vertexbuffer(0),
+    m_indexbuffer(0),
+    m_instancebuffer(0),
+    m_vertexcapacity(0),
+    m_indexcapacity(0),
+    m_instancecapacity(0),
+    m_dirty(false),
+    m_indicesdirty(false),
+    m_instancesdirty(false),
+    m_vertexframe(0),
+    m_instanceframe(0)
 {
+    assert(attribs & VA_POSITION);
+    for (int i = 0; i < 3; ++i) {
+        if (attribs & (1 << i)) {
+            m_stride += 3;
+        }
+    }
+}
+
+// The GL context that was current in draw() must still be current here.
+VertexRecorder::~VertexRecorder()
+{
+    if (m_vertexarray != 0) {
+        glDeleteBuffers(1, &m_vertexbuffer);
+        glDeleteBuffers(1, &m_indexbuffer);
+        glDeleteBuffers(1, &m_instancebuffer);
+        glDeleteVertexArrays(1, &m_vertexarray);
+    }
 }
 
 void VertexRecorder::record(Vector3f pos,
@@ -24,123 +64,343 @@ void VertexRecorder::record_poscolor(Vector3f pos,
 void VertexRecorder::record(Vector3f pos,
     Vector3f normal,
     Vector3f color) {
-    m_position.push_back(pos);
-    m_normal.push_back(normal);
-    m_color.push_back(color);
+    const Vector3f* attrib[3] = { &pos, &normal, &color };
+    for (int i = 0; i < 3; ++i) {
+        if (m_attribs & (1 << i)) {
+            m_data.push_back(attrib[i]->x());
+            m_data.push_back(attrib[i]->y());
+            m_data.push_back(attrib[i]->z());
+        }
+    }
     m_nverts++;
+    m_dirty = true;
+}
+void VertexRecorder::record_triangle(uint32_t i, uint32_t j, uint32_t k)
+{
+    assert(i < (uint32_t)m_nverts && j < (uint32_t)m_nverts && k < (uint32_t)m_nverts);
+    m_indices.push_back(i);
+    m_indices.push_back(j);
+    m_indices.push_back(k);
+    m_indicesdirty = true;
+}
+void VertexRecorder::record_instance(const Matrix4f& M,
+    Vector3f color)
+{
+    size_t offset = m_instances.size();
+    m_instances.resize(offset + 20);
+    m_instances[offset + 0] = color.x();
+    m_instances[offset + 1] = color.y();
+    m_instances[offset + 2] = color.z();
+    m_instances[offset + 3] = 1.0f;
+    memcpy(&m_instances[offset + 4], (const float*)M, 16 * sizeof(float));
+    m_instancesdirty = true;
 }
 
-/* This implementation uploads data to the GPU on each draw call.
-   A more efficient implementation would only upload when the vertex
-   data changed.
+/* The vertex array and buffers are created on the first draw call and
+   kept until the recorder is destroyed. Vertex data is only uploaded
+   when it changed since the last draw, so recordings that are made once
+   and drawn every frame cost no upload after the first frame.
 */
+void VertexRecorder::bind()
+{
+    if (m_vertexarray == 0) {
+        glGenVertexArrays(1, &m_vertexarray);
+        glBindVertexArray(m_vertexarray);
+        glGenBuffers(1, &m_vertexbuffer);
+        // the element buffer binding is part of the vertex array
+        glGenBuffers(1, &m_indexbuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexbuffer);
+    } else {
+        glBindVertexArray(m_vertexarray);
+    }
+
+    // disabled attributes read the current generic value, which is
+    // context state and not part of the vertex array
+    if (!(m_attribs & VA_NORMAL)) {
+        glVertexAttrib3f(1, 0, 0, 0);
+    }
+    if (!(m_attribs & VA_COLOR)) {
+        glVertexAttrib3f(2, 1, 1, 1);
+    }
+
+    bool stale = m_usage == VU_STREAM && m_vertexframe != frameStream().frame();
+    if (m_dirty || m_indicesdirty || stale) {
+        upload();
+    }
+}
+
+// Attribute i (position, normal, color) follows the stored attributes
+// before it. The vertex array must be bound.
+void VertexRecorder::setVertexPointers(uint32_t buffer, size_t offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (int i = 0; i < 3; ++i) {
+        if (m_attribs & (1 << i)) {
+            glEnableVertexAttribArray(i);
+            glVertexAttribPointer(i,
+                3,
+                GL_FLOAT,
+                GL_FALSE,
+                m_stride * sizeof(float),
+                (void*)offset);
+            offset += 3 * sizeof(float);
+        }
+    }
+}
+
+// Attribute 3 is the color, 4 to 7 are the columns of M, advancing once
+// per instance. The vertex array must be bound.
+void VertexRecorder::setInstancePointers(uint32_t buffer, size_t offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (int i = 0; i < 5; ++i) {
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribPointer(3 + i,
+            4,
+            GL_FLOAT,
+            GL_FALSE,
+            20 * sizeof(float),
+            (void*)(offset + 4 * i * sizeof(float)));
+        glVertexAttribDivisor(3 + i, 1);
+    }
+}
+
+// Larger recordings would fill the ring in a frame or two and make
+// every write wait for the GPU.
+bool VertexRecorder::streams(VertexUsage usage, size_t nbytes) const
+{
+    return usage == VU_STREAM && nbytes <= frameStream().size() / 4;
+}
+
 void VertexRecorder::draw(GLenum mode)
 {
     if (m_nverts == 0) {
         return;
     }
-    // upload data to GPU
-    uint32_t vertexarray;
-    glGenVertexArrays(1, &vertexarray);
-    glBindVertexArray(vertexarray);
-    uint32_t vertexbuffer[3];
-    glGenBuffers(3, vertexbuffer);
-
-    // POSITION
-    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer[0]);
-    size_t position_nbytes = m_nverts * sizeof(m_position[0]);
-    glBufferData(GL_ARRAY_BUFFER, position_nbytes,
-        m_position.data(), GL_DYNAMIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0,
-        3,
-        GL_FLOAT,
-        GL_FALSE,
-        sizeof(m_position[0]),
-        (void*)0);
-
-    // NORMALS
-    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer[1]);
-    size_t normal_nbytes = m_nverts * sizeof(m_normal[0]);
-    glBufferData(GL_ARRAY_BUFFER, normal_nbytes,
-        m_normal.data(), GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1,
-        3,
-        GL_FLOAT,
-        GL_FALSE,
-        sizeof(m_normal[0]),
-        (void*)0);
-
-    // COLOR
-    glBindBuffer(GL_ARRAY_BUFFER, vertexbuffer[2]);
-    size_t color_nbytes = m_nverts * sizeof(m_color[0]);
-    glBufferData(GL_ARRAY_BUFFER, color_nbytes,
-        m_color.data(), GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2,
-        3,
-        GL_FLOAT,
-        GL_FALSE,
-        sizeof(m_color[0]),
-        (void*)0);
-
-    // Everything is uploaded.
-    // Now draw.
-    glDrawArrays(mode, 0, m_nverts);
-
-    // Release allocated buffers/arrays.
-    glDeleteBuffers(3, vertexbuffer);
-    glDeleteVertexArrays(1, &vertexarray);
+    bind();
+    if (m_indices.empty()) {
+        glDrawArrays(mode, 0, m_nverts);
+    } else {
+        glDrawElements(mode, (GLsizei)m_indices.size(), GL_UNSIGNED_INT, (void*)0);
+    }
+    glBindVertexArray(0);
 }
+
+// Uploads nbytes to the buffer bound to target, in place if it fits
+// into the capacity bytes the buffer already has.
+static void uploadBuffer(GLenum target, const void* data, size_t nbytes,
+    size_t* capacity)
+{
+    if (nbytes == 0) {
+        return;
+    }
+    if (nbytes <= *capacity) {
+        glBufferSubData(target, 0, nbytes, data);
+    } else {
+        // the first upload is usually the only one (static recordings),
+        // growing the buffer means the recording changes between frames
+        glBufferData(target, nbytes, data,
+            *capacity == 0 ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+        *capacity = nbytes;
+    }
+}
+
+/* The vertex array must be bound, it holds the element buffer binding.
+   Streamed vertices land at a different offset of the frame stream on
+   every upload, so the attribute pointers are set again each time; the
+   indices stay in the recorder's own buffer, as they rarely change.
+*/
+void VertexRecorder::upload()
+{
+    size_t nbytes = m_data.size() * sizeof(float);
+    if (streams(m_usage, nbytes)) {
+        StreamBuffer& stream = frameStream();
+        size_t offset = stream.write(m_data.data(), nbytes);
+        setVertexPointers(stream.buffer(), offset);
+        m_vertexframe = stream.frame();
+    } else if (m_dirty) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexbuffer);
+        uploadBuffer(GL_ARRAY_BUFFER, m_data.data(), nbytes, &m_vertexcapacity);
+        setVertexPointers(m_vertexbuffer, 0);
+    }
+    if (m_indicesdirty) {
+        uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indices.data(),
+            m_indices.size() * sizeof(uint32_t), &m_indexcapacity);
+    }
+    m_dirty = false;
+    m_indicesdirty = false;
+}
+
+/* Instances are kept in a separate buffer with one entry per instance
+   (glVertexAttribDivisor 1), so the vertices are uploaded once and only
+   the instances change between frames. The program's instanced uniform
+   switches the shaders to the per-instance attributes for this draw.
+*/
+void VertexRecorder::draw_instanced(const ShaderProgram& program, GLenum mode)
+{
+    GLsizei ninstances = (GLsizei)(m_instances.size() / 20);
+    if (m_nverts == 0 || ninstances == 0) {
+        return;
+    }
+    bind();
+    size_t nbytes = m_instances.size() * sizeof(float);
+    if (streams(m_instanceusage, nbytes)) {
+        StreamBuffer& stream = frameStream();
+        if (m_instancesdirty || m_instanceframe != stream.frame()) {
+            size_t offset = stream.write(m_instances.data(), nbytes);
+            setInstancePointers(stream.buffer(), offset);
+            m_instanceframe = stream.frame();
+        }
+    } else if (m_instancesdirty) {
+        if (m_instancebuffer == 0) {
+            glGenBuffers(1, &m_instancebuffer);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, m_instancebuffer);
+        uploadBuffer(GL_ARRAY_BUFFER, m_instances.data(), nbytes, &m_instancecapacity);
+        setInstancePointers(m_instancebuffer, 0);
+    }
+    m_instancesdirty = false;
+
+    glUniform1i(program[U_INSTANCED], 1);
+    if (m_indices.empty()) {
+        glDrawArraysInstanced(mode, 0, m_nverts, ninstances);
+    } else {
+        glDrawElementsInstanced(mode, (GLsizei)m_indices.size(), GL_UNSIGNED_INT, (void*)0, ninstances);
+    }
+    glUniform1i(program[U_INSTANCED], 0);
+    glBindVertexArray(0);
+}
+
 void VertexRecorder::clear()
 {
     m_nverts = 0;
-    m_position.clear();
-    m_normal.clear();
-    m_color.clear();
+    m_data.clear();
+    m_indices.clear();
+    m_instances.clear();
+    m_dirty = true;
+    m_indicesdirty = true;
+    m_instancesdirty = true;
+}
+
+void VertexRecorder::clear_instances()
+{
+    m_instances.clear();
+    m_instancesdirty = true;
 }
 
-void drawSphere(float r, int slices, int stacks) {
+void VertexRecorder::clear_vertices()
+{
+    m_nverts = 0;
+    m_data.clear();
+    m_dirty = true;
+}
+
+int VertexRecorder::vertex_count() const
+{
+    return m_nverts;
+}
+
+int VertexRecorder::index_count() const
+{
+    return (int)m_indices.size();
+}
+
+/* drawSphere, drawCylinder and drawQuad record one unit size mesh per
+   level of detail and keep it on the GPU. The size is applied by scaling
+   the model matrix the caller passes for the draw, so sizes can change
+   every frame without recording anything or reading GL state back. Scaling these shapes
+   along their axes does not turn their normals, so N is left as it is.
+*/
+namespace {
+struct PrimitiveCache {
+    std::map<std::pair<int, int>, std::unique_ptr<VertexRecorder>> spheres;
+    std::map<int, std::unique_ptr<VertexRecorder>> cylinders;
+};
+// allocated on first use and freed by freePrimitives(), so that no GL
+// objects are deleted after the context is gone
+PrimitiveCache* s_primitives = nullptr;
+
+// Returns the mesh for key, or a new empty recorder for it that the
+// caller has to fill.
+template <typename Map>
+VertexRecorder* cachedMesh(Map& meshes, const typename Map::key_type& key, bool* created)
+{
+    typename Map::iterator it = meshes.find(key);
+    if (it != meshes.end()) {
+        *created = false;
+        return it->second.get();
+    }
+    VertexRecorder* rec = new VertexRecorder(VA_POS_NORMAL);
+    meshes[key].reset(rec);
+    *created = true;
+    return rec;
+}
+
+PrimitiveCache& primitives()
+{
+    if (!s_primitives) {
+        s_primitives = new PrimitiveCache();
+    }
+    return *s_primitives;
+}
+
+// Draws rec with the M uniform of program set to M scaled by
+// (sx, sy, sz), then sets M again.
+void drawScaled(VertexRecorder* rec, const ShaderProgram& program, const Matrix4f& M,
+    float sx, float sy, float sz)
+{
+    int loc = program[U_M];
+    glUniformMatrix4fv(loc, 1, GL_FALSE, M * Matrix4f::scaling(sx, sy, sz));
+    rec->draw();
+    glUniformMatrix4fv(loc, 1, GL_FALSE, M);
+}
+}
+
+void freePrimitives()
+{
+    delete s_primitives;
+    s_primitives = nullptr;
+}
+
+void drawSphere(float r, int slices, int stacks,
+    const ShaderProgram& program, const Matrix4f& M) {
+    bool created;
+    VertexRecorder* rec = cachedMesh(primitives().spheres,
+        std::make_pair(slices, stacks), &created);
+    if (created) {
+        recordSphere(1.0f, slices, stacks, rec);
+    }
+    drawScaled(rec, program, M, r, r, r);
+}
+
+void recordSphere(float r, int slices, int stacks, VertexRecorder* recorder) {
     assert(slices > 1);
     assert(stacks > 1);
     assert(r > 0);
+    VertexRecorder& rec = *recorder;
 
-    // TODO reuse recorder if sphere meshing becomes a bottleneck.
-    VertexRecorder rec;
-
-    float phistep = M_PIf * 2 / slices;
-    float thetastep = M_PIf / stacks;
+    // sin and cos of the longitudes phi and the latitudes theta, shared
+    // by all spheres with the same slices and stacks
+    const AngleTable& phi = AngleTable::get(slices);
+    const AngleTable& theta = AngleTable::get(stacks, M_PIf);
 
     for (int vi = 0; vi < stacks; ++vi) { // vertical loop
-        float theta = vi * thetastep;
-        float theta_next = (vi + 1) * thetastep;
-
-        float z = r * cosf(theta);
-        float z_next = r*cosf(theta_next);
         for (int hi = 0; hi < slices; ++hi) { // horizontal loop
-            float phi = hi * phistep;
-            float phi_next = (hi + 1) * phistep;
-
-            float x = r * cosf(phi) * sinf(theta);
-            float y = r * sinf(phi) * sinf(theta);
+            // the normals are the unit sphere points, positions are r * n
+            Vector3f n1(phi.cos(hi) * theta.sin(vi), phi.sin(hi) * theta.sin(vi), theta.cos(vi));
+            Vector3f n2(phi.cos(hi + 1) * theta.sin(vi), phi.sin(hi + 1) * theta.sin(vi), theta.cos(vi));
+            Vector3f n3(phi.cos(hi + 1) * theta.sin(vi + 1), phi.sin(hi + 1) * theta.sin(vi + 1), theta.cos(vi + 1));
+            Vector3f n4(phi.cos(hi) * theta.sin(vi + 1), phi.sin(hi) * theta.sin(vi + 1), theta.cos(vi + 1));
 
-            Vector3f p1(r * cosf(phi) * sinf(theta), r * sinf(phi) * sinf(theta), z);
-            Vector3f p2(r * cosf(phi_next) * sinf(theta), r * sinf(phi_next) * sinf(theta), z);
-            Vector3f p3(r * cosf(phi_next) * sinf(theta_next), r * sinf(phi_next) * sinf(theta_next), z_next);
-            Vector3f p4(r * cosf(phi) * sinf(theta_next), r * sinf(phi) * sinf(theta_next), z_next);
-
-            Vector3f n1 = p1.normalized();
-            Vector3f n2 = p2.normalized();
-            Vector3f n3 = p3.normalized();
-            Vector3f n4 = p4.normalized();
+            Vector3f p1 = r * n1;
+            Vector3f p2 = r * n2;
+            Vector3f p3 = r * n3;
+            Vector3f p4 = r * n4;
 
             rec.record(p1, n1); rec.record(p2, n2); rec.record(p3, n3);
             rec.record(p1, n1); rec.record(p3, n3); rec.record(p4, n4);
         }
     }
-    rec.draw();
 }
 /*
 void drawCube(float w) {
@@ -148,7 +408,7 @@ void drawCube(float w) {
     float wh = w / 2.0f;
 
     // TODO reuse recorder if cube meshing becomes a bottleneck.
-    VertexRecorder rec;
+    VertexRecorder rec(VA_POS_NORMAL);
     Vector3f nx1 = Vector3f(-wh, -wh, -wh);
     Vector3f nx2 = Vector3f(-wh, +wh, -wh);
     Vector3f nx3 = Vector3f(-wh, +wh, +wh);
@@ -169,11 +429,21 @@ void drawCube(float w) {
     rec.draw();
 }*/
 
-void drawCylinder(int nsides, float r, float h) {
+void drawCylinder(int nsides, float r, float h,
+    const ShaderProgram& program, const Matrix4f& M) {
+    bool created;
+    VertexRecorder* rec = cachedMesh(primitives().cylinders, nsides, &created);
+    if (created) {
+        recordCylinder(nsides, 1.0f, 1.0f, rec);
+    }
+    drawScaled(rec, program, M, r, h, r);
+}
+
+void recordCylinder(int nsides, float r, float h, VertexRecorder* recorder) {
     assert(nsides >= 3);
-    float step = 2 * M_PIf / nsides;
+    const AngleTable& angles = AngleTable::get(nsides);
 
-    VertexRecorder rec;
+    VertexRecorder& rec = *recorder;
     std::vector<Vector3f> pos;
     std::vector<Vector3f> n;
 
@@ -182,13 +452,15 @@ void drawCylinder(int nsides, float r, float h) {
     int uvidx = 0;
     int idxidx = 0;
     for (int face = 0; face < nsides; ++face) {
-        float lx = r * cosf(face * step);
-        float lz = r * sinf(face * step);
+        float c = angles.cos(face);
+        float s = angles.sin(face);
+        float lx = r * c;
+        float lz = r * s;
         pos.push_back(Vector3f(lx, 0.0f, lz));
         pos.push_back(Vector3f(lx, h, lz));
 
-        n.push_back(Vector3f(cosf(face * step), 0.0f, sinf(face * step)));
-        n.push_back(Vector3f(cosf(face * step), h, sinf(face * step)));
+        n.push_back(Vector3f(c, 0.0f, s));
+        n.push_back(Vector3f(c, 0.0f, s));
 
         //if (uv) {
             //uv[uvidx++] = (float)(face) / (nsides - 1);
@@ -225,6 +497,5 @@ void drawCylinder(int nsides, float r, float h) {
         rec.record(pos[i2], n[i2]);
         rec.record(pos[i3], n[i3]);
     }
-    rec.draw();
 }
 void drawCylinder() {}
@@ -1,13 +1,53 @@
 #ifndef RECORDER_H
 #define RECORDER_H
 
+#include <cstdint>
 #include <vector>
 #include <vecmath.h>
 #include "gl.h"
 
+struct ShaderProgram;
+
+// Vertex attributes stored by a VertexRecorder, matching the attribute
+// locations of the shaders (0 position, 1 normal, 2 color).
+enum VertexAttribs {
+    VA_POSITION = 1 << 0,
+    VA_NORMAL = 1 << 1,
+    VA_COLOR = 1 << 2,
+
+    VA_POS = VA_POSITION,
+    VA_POS_NORMAL = VA_POSITION | VA_NORMAL,
+    VA_POS_COLOR = VA_POSITION | VA_COLOR,
+    VA_POS_NORMAL_COLOR = VA_POSITION | VA_NORMAL | VA_COLOR
+};
+
+// Where a VertexRecorder keeps its vertices and instances on the GPU.
+enum VertexUsage {
+    // in buffers of its own, for recordings made once and drawn often
+    VU_STATIC,
+    // in the shared frameStream(), for recordings made again every frame.
+    // Recordings too large for the stream fall back to VU_STATIC.
+    VU_STREAM
+};
+
+// Records vertices into a single interleaved buffer that only holds the
+// attributes selected at construction. Attributes that are not stored are
+// dropped by record() and read by the shaders as constants: normal (0, 0, 0)
+// and color (1, 1, 1), the values record() fills in when they are omitted.
 class VertexRecorder{ 
 public:
-    VertexRecorder();
+    // attribs is a combination of VertexAttribs and must include VA_POSITION.
+    // usage applies to the vertices, instanceUsage to the instances, so a
+    // mesh recorded once can stream instances recorded every frame.
+    explicit VertexRecorder(int attribs = VA_POS_NORMAL_COLOR,
+                VertexUsage usage = VU_STATIC,
+                VertexUsage instanceUsage = VU_STATIC);
+    // deletes the GL buffers
+    ~VertexRecorder();
+    // owns GL objects, so it cannot be copied
+    VertexRecorder(const VertexRecorder&) = delete;
+    VertexRecorder& operator=(const VertexRecorder&) = delete;
+
     // write a vertex into the CPU buffer
     void record(Vector3f pos,
                 Vector3f normal);
@@ -16,23 +56,93 @@ public:
 		        Vector3f color);
     void record_poscolor(Vector3f pos,
 		        Vector3f color);
-    // draw recorded points
+    // write a triangle into the CPU index buffer. i, j and k index the
+    // vertices recorded since the last clear(). Once a triangle is
+    // recorded, draw() draws the triangles instead of the vertices in
+    // order, so shared vertices only need to be recorded once.
+    void record_triangle(uint32_t i, uint32_t j, uint32_t k);
+    // write an instance into the CPU instance buffer: a model matrix,
+    // applied before the program's M, and a color that tints the
+    // diffuse color of lit programs.
+    void record_instance(const Matrix4f& M,
+                Vector3f color = Vector3f(1, 1, 1));
+    // draw recorded points, uploading them first if they changed
     void draw(GLenum mode = GL_TRIANGLES);
+    // draw the recording once per recorded instance, in one draw call.
+    // program must be the active program.
+    void draw_instanced(const ShaderProgram& program,
+                GLenum mode = GL_TRIANGLES);
     // empties the recording buffer.
     void clear();
+    // empties the instance buffer, keeping the vertices.
+    void clear_instances();
+    // empties the vertices, keeping the triangles and instances. The
+    // vertices recorded next replace them one for one, e.g. when a mesh
+    // is deformed every frame but its faces do not change.
+    void clear_vertices();
+    // number of vertices recorded since the last clear()
+    int vertex_count() const;
+    // number of triangle indices recorded since the last clear()
+    int index_count() const;
 private:
+    // binds the vertex array, creating it and uploading the
+    // vertices if needed
+    void bind();
+    // copies the CPU buffers to the GL buffers
+    void upload();
+    // points the vertex attributes at buffer, starting at offset bytes
+    void setVertexPointers(uint32_t buffer, size_t offset);
+    // same for the instance attributes
+    void setInstancePointers(uint32_t buffer, size_t offset);
+    // true if nbytes of data with this usage should go to the frame stream
+    bool streams(VertexUsage usage, size_t nbytes) const;
+
+    int m_attribs; // VertexAttribs
+    VertexUsage m_usage;
+    VertexUsage m_instanceusage;
+    int m_stride; // floats per vertex
     int m_nverts;
-    std::vector<Vector3f> m_position;
-    std::vector<Vector3f> m_normal;
-    std::vector<Vector3f> m_color;
+    std::vector<float> m_data; // interleaved position, normal, color
+    std::vector<uint32_t> m_indices; // 3 per triangle
+    std::vector<float> m_instances; // color (4 floats), then M (16 floats)
+
+    // GL objects, created on the first draw
+    uint32_t m_vertexarray;
+    uint32_t m_vertexbuffer;
+    uint32_t m_indexbuffer;
+    uint32_t m_instancebuffer; // created on the first instanced draw
+    size_t m_vertexcapacity; // bytes the GL buffers can hold
+    size_t m_indexcapacity;
+    size_t m_instancecapacity;
+    bool m_dirty; // vertices changed since the last upload
+    bool m_indicesdirty; // triangles changed since the last upload
+    bool m_instancesdirty; // instances changed since the last upload
+    // VU_STREAM: frame of the stream the vertices and instances were
+    // written in, they are written again in every later frame
+    uint64_t m_vertexframe;
+    uint64_t m_instanceframe;
 };
 
+// The draw functions below record one unit size mesh per level of
+// detail and keep it on the GPU. program must be the active program and
+// M the model matrix last set on it; the size is applied by setting M
+// scaled for the draw, and M is set again afterwards.
+// freePrimitives() deletes the meshes; call it before the GL context
+// is destroyed.
+void freePrimitives();
+
 // draw a sphere with radius r centered at (0,0,0)
 // slices and stacks control the level of detail of the sphere
-void drawSphere(float r, int slices, int stacks);
+void drawSphere(float r, int slices, int stacks,
+                const ShaderProgram& program, const Matrix4f& M);
+// record the triangles of that sphere, e.g. to draw it instanced
+void recordSphere(float r, int slices, int stacks, VertexRecorder* recorder);
 
 // draw a cylinder. the cylinder extends from y=0 to y=h
 // and from -r to +r in the XZ plane.
-void drawCylinder(int nsides, float r, float h);
+void drawCylinder(int nsides, float r, float h,
+                const ShaderProgram& program, const Matrix4f& M);
+// record the triangles of that cylinder, e.g. to draw it instanced
+void recordCylinder(int nsides, float r, float h, VertexRecorder* recorder);
 
 #endif
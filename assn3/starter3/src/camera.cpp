@@ -1,11 +1,14 @@
 #include "camera.h"
+#include <cstring>
 #include <iostream>
 #include "gl.h"
+#include "starter3_util.h"
 using namespace std;
 
 const float c_pi = 3.14159265358979323846f;
 
-Camera::Camera()
+Camera::Camera() :
+    mCameraBuffer(0)
 {
     mStartRot = Matrix4f::identity();
     mCurrentRot = Matrix4f::identity();
@@ -219,30 +222,48 @@ Matrix4f Camera::GetPerspective() const
 
 Matrix4f Camera::GetViewMatrix() const
 {
-    Matrix4f C = Matrix4f::translation(-mCurrentCenter) * mCurrentRot.inverse() * Matrix4f::translation(0, 0, mCurrentDistance);
-    return C.inverse();
+    Matrix4f C = Matrix4f::translation(-mCurrentCenter) * mCurrentRot.inverseRigid() * Matrix4f::translation(0, 0, mCurrentDistance);
+    return C.inverseRigid();
 }
 
-void Camera::SetUniforms(uint32_t program, Matrix4f M) const
+void Camera::UpdateCameraBlock()
 {
+    Matrix4f P = GetPerspective();
     Matrix4f V = GetViewMatrix();
-    Matrix4f C = V.inverse();
-    Vector3f eye = C.getCol(3).xyz();
-    int loc = glGetUniformLocation(program, "P");
-    glUniformMatrix4fv(loc, 1, false, GetPerspective());
-
-    loc = glGetUniformLocation(program, "V");
-    glUniformMatrix4fv(loc, 1, false, GetViewMatrix());
+    Vector3f eye = V.inverseRigid().getCol(3).xyz();
+
+    // std140 layout: two mat4, then camPos padded to a vec4
+    float data[16 + 16 + 4] = {};
+    memcpy(data, (const float*)P, 16 * sizeof(float));
+    memcpy(data + 16, (const float*)V, 16 * sizeof(float));
+    memcpy(data + 32, (const float*)eye, 3 * sizeof(float));
+
+    if (mCameraBuffer == 0) {
+        glGenBuffers(1, &mCameraBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, mCameraBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(data), NULL, GL_DYNAMIC_DRAW);
+    } else {
+        glBindBuffer(GL_UNIFORM_BUFFER, mCameraBuffer);
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(data), data);
+    // bound every frame in case other code used the binding point
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, mCameraBuffer);
+}
 
-    loc = glGetUniformLocation(program, "camPos");
-    glUniform3fv(loc, 1, eye);
+void Camera::SetUniforms(const ShaderProgram& program, Matrix4f M) const
+{
+	int loc = program[U_M];
+	glUniformMatrix4fv(loc, 1, false, M);
 
-    loc = glGetUniformLocation(program, "M");
-    glUniformMatrix4fv(loc, 1, false, M);
+	Matrix4f N = M.normalMatrix();
+	loc = program[U_N];
+	glUniformMatrix4fv(loc, 1, false, N);
+}
 
-    Matrix4f N = M.inverse().transposed();
-    loc = glGetUniformLocation(program, "N");
-    glUniformMatrix4fv(loc, 1, false, N);
+void Camera::FreeCameraBlock()
+{
+    glDeleteBuffers(1, &mCameraBuffer);
+    mCameraBuffer = 0;
 }
 
 
@@ -3,6 +3,7 @@
 #include "clothsystem.h"
 #include "camera.h"
 #include "vertexrecorder.h"
+#include "glstate.h"
 
  // your system should at least contain 8x8 particles.
 const int W = 10;
@@ -11,7 +12,7 @@ const float CLOTH_CELL_SIZE = 0.2;
 
 const float EPS = 1e-6;
 
-const Vector3f G = Vector3f(0.0, -9.81, 0.0);
+const StateVector G = StateVector(0.0, -9.81, 0.0);
 const float VISCOUS_K = 0.1;
 
 const float STRUCTURAL_SPRING_K = 50.0;
@@ -24,8 +25,11 @@ const float FLEXION_SPRING_K = 2.0;
 const float FLEXION_SPRING_LENGTH = 0.4;
 
 
-ClothSystem::ClothSystem()
+ClothSystem::ClothSystem() :
+    m_particles(0.04f, 8, 8),
+    m_wireframe(VA_POS, VU_STREAM)
 {
+
     // TODO 5. Initialize m_vVecState with cloth particles. 
     // You can again use rand_uniform(lo, hi) to make things a bit more interesting
     m_h = H;
@@ -50,58 +54,58 @@ ClothSystem::ClothSystem()
             float y = 0.0 - i * CLOTH_CELL_SIZE;
             float z = 0.0;
 
-            m_vVecState.push_back(Vector3f(x, y, z));  // positions
-            m_vVecState.push_back(Vector3f(0.0, 0.0, 0.0));  // velocities
+            m_vVecState.push_back(StateVector(x, y, z));  // positions
+            m_vVecState.push_back(StateVector(0.0, 0.0, 0.0));  // velocities
         }
     }
 }
 
 
-std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
+std::vector<StateVector> ClothSystem::evalF(std::vector<StateVector> state)
 {
     // TODO 5. implement evalF
     int numParticles = m_h * m_w;
-    std::vector<Vector3f> f;
+    std::vector<StateVector> f;
     
     // - gravity
-    std::vector<Vector3f> forcesGravity(numParticles);
+    std::vector<StateVector> forcesGravity(numParticles);
     for (int i = 0; i < numParticles; ++i) {
         forcesGravity[i] = m_masses[i] * G;
     }
 
     // - viscous drag
-    std::vector<Vector3f> forcesViscous(numParticles);
+    std::vector<StateVector> forcesViscous(numParticles);
     for (int i = 0; i < numParticles; ++i) {
         forcesViscous[i] = -m_viscous_k * state[2 * i + 1];
     }
 
     // - structural springs
-    std::vector<Vector3f> forcesStructuralSpring(numParticles);
+    std::vector<StateVector> forcesStructuralSpring(numParticles);
     for (int i = 0; i < m_h; ++i) {
         for (int j = 0; j < m_w; ++j) {
-            Vector3f forceStructuralSpring(0.0, 0.0, 0.0);
+            StateVector forceStructuralSpring(0.0, 0.0, 0.0);
 
             // top
             if (i - 1 >= 0) {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(i - 1, j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(i - 1, j)];
                 forceStructuralSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
             // left
             if (j - 1 >= 0) {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(i, j - 1)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(i, j - 1)];
                 forceStructuralSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
             // bottom
             if (i + 1 <= m_h - 1) {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(i + 1, j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(i + 1, j)];
                 forceStructuralSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
             // right
             if (j + 1 <= m_w - 1) {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(i, j + 1)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(i, j + 1)];
                 forceStructuralSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
@@ -110,10 +114,10 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
     }
 
     // - shear springs
-    std::vector<Vector3f> forcesShearSpring(numParticles);
+    std::vector<StateVector> forcesShearSpring(numParticles);
     for (int i = 0; i < m_h; ++i) {
         for (int j = 0; j < m_w; ++j) {
-            Vector3f forceShearSpring(0.0, 0.0, 0.0);
+            StateVector forceShearSpring(0.0, 0.0, 0.0);
 
             int new_i, new_j;
 
@@ -121,7 +125,7 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
             new_i = i + 1;
             new_j = j + 1;
             if ((new_i >= 0) && (new_i <= m_h - 1) && (new_j >= 0) && (new_j<= m_w - 1))  {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
                 forceShearSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
@@ -129,7 +133,7 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
             new_i = i - 1;
             new_j = j - 1;
             if ((new_i >= 0) && (new_i <= m_h - 1) && (new_j >= 0) && (new_j<= m_w - 1))  {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
                 forceShearSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
@@ -137,7 +141,7 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
             new_i = i + 1;
             new_j = j - 1;
             if ((new_i >= 0) && (new_i <= m_h - 1) && (new_j >= 0) && (new_j<= m_w - 1))  {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
                 forceShearSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
@@ -145,7 +149,7 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
             new_i = i - 1;
             new_j = j + 1;
             if ((new_i >= 0) && (new_i <= m_h - 1) && (new_j >= 0) && (new_j<= m_w - 1))  {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
                 forceShearSpring += -m_structural_spring_k * (d.abs() - m_structural_spring_length) * (d / (EPS + d.abs()));
             }
 
@@ -154,10 +158,10 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
     }
 
     // - flexion springs
-    std::vector<Vector3f> forcesFlexionSpring(numParticles);
+    std::vector<StateVector> forcesFlexionSpring(numParticles);
     for (int i = 0; i < m_h; ++i) {
         for (int j = 0; j < m_w; ++j) {
-            Vector3f forceFlexionSpring(0.0, 0.0, 0.0);
+            StateVector forceFlexionSpring(0.0, 0.0, 0.0);
 
             int new_i, new_j;
 
@@ -165,14 +169,14 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
             new_i = i + 2;
             new_j = j;
             if ((new_i >= 0) && (new_i <= m_h - 1) && (new_j >= 0) && (new_j<= m_w - 1))  {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
                 forceFlexionSpring += -m_flexion_spring_k * (d.abs() - m_flexion_spring_length) * (d / (EPS + d.abs()));
             }
 
             new_i = i;
             new_j = j + 2;
             if ((new_i >= 0) && (new_i <= m_h - 1) && (new_j >= 0) && (new_j<= m_w - 1))  {
-                Vector3f d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
+                StateVector d = state[2 * indexOf(i, j)] - state[2 * indexOf(new_i, new_j)];
                 forceFlexionSpring += -m_flexion_spring_k * (d.abs() - m_flexion_spring_length) * (d / (EPS + d.abs()));
             }
 
@@ -182,7 +186,7 @@ std::vector<Vector3f> ClothSystem::evalF(std::vector<Vector3f> state)
 
 
     // sum up all
-    std::vector<Vector3f> accelerations(numParticles);
+    std::vector<StateVector> accelerations(numParticles);
     for (int i = 0; i < numParticles; ++i) {
         accelerations[i] = (
             forcesGravity[i] + \
@@ -222,13 +226,13 @@ void ClothSystem::draw(GLProgram& gl)
 
     // EXAMPLE for how to render cloth particles.
     //  - you should replace this code.
+    // All particles are drawn in one call, see ParticleSpheres.
     for (int i = 0; i < m_h; ++i) {
         for (int j = 0; j < m_w; ++j) {
-            Vector3f position = m_vVecState[2 * indexOf(i, j)];
-            gl.updateModelMatrix(Matrix4f::translation(position));
-            drawSphere(0.04f, 8, 8);
+            m_particles.add(Vector3f(m_vVecState[2 * indexOf(i, j)]));
         }
     }
+    m_particles.draw(gl);
     
     // EXAMPLE: This shows you how to render lines to debug the spring system.
     //
@@ -243,22 +247,24 @@ void ClothSystem::draw(GLProgram& gl)
     //          after a mode change.
     gl.disableLighting();
     gl.updateModelMatrix(Matrix4f::identity()); // update uniforms after mode change
-    VertexRecorder rec;
+    // lighting is off, so only positions are needed; the color
+    // attribute reads the recorder's constant white
+    m_wireframe.clear();
     for (int i = 0; i < m_h; ++i) {
         for (int j = 0; j < m_w; ++j) {
             if ((j + 1) < m_w) {
-                rec.record(m_vVecState[2 * indexOf(i, j)], CLOTH_COLOR);
-                rec.record(m_vVecState[2 * indexOf(i, j + 1)], CLOTH_COLOR);
+                m_wireframe.record(Vector3f(m_vVecState[2 * indexOf(i, j)]), CLOTH_COLOR);
+                m_wireframe.record(Vector3f(m_vVecState[2 * indexOf(i, j + 1)]), CLOTH_COLOR);
             }
 
             if ((i + 1) < m_h) {
-                rec.record(m_vVecState[2 * indexOf(i, j)], CLOTH_COLOR);
-                rec.record(m_vVecState[2 * indexOf(i + 1, j)], CLOTH_COLOR);
+                m_wireframe.record(Vector3f(m_vVecState[2 * indexOf(i, j)]), CLOTH_COLOR);
+                m_wireframe.record(Vector3f(m_vVecState[2 * indexOf(i + 1, j)]), CLOTH_COLOR);
             }
         }
     }
-    glLineWidth(3.0f);
-    rec.draw(GL_LINES);
+    setLineWidth(3.0f);
+    m_wireframe.draw(GL_LINES);
     gl.enableLighting(); // reset to default lighting model
 }
 
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "particlesystem.h"
+#include "vertexrecorder.h"
 
 class ClothSystem : public ParticleSystem
 {
@@ -12,7 +13,7 @@ public:
     ClothSystem();
 
     // evalF is called by the integrator at least once per time step
-    std::vector<Vector3f> evalF(std::vector<Vector3f> state) override;
+    std::vector<StateVector> evalF(std::vector<StateVector> state) override;
 
     // helper function
     int indexOf(int i, int j);
@@ -21,7 +22,7 @@ public:
     void draw(GLProgram& ctx);
 
     // inherits
-    // std::vector<Vector3f> m_vVecState;
+    // std::vector<StateVector> m_vVecState;
 
 private:
     size_t m_h;
@@ -38,6 +39,11 @@ private:
 
     float m_flexion_spring_k;
     float m_flexion_spring_length;
+
+    // a sphere at every particle
+    ParticleSpheres m_particles;
+    // the wireframe lines, recorded again every frame
+    VertexRecorder m_wireframe;
 };
 
 
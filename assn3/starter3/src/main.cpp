@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "vertexrecorder.h"
+#include "glstate.h"
+#include "streambuffer.h"
 #include "starter3_util.h"
 #include "camera.h"
 #include "timestepper.h"
@@ -50,8 +52,11 @@ char integrator;
 
 Camera camera;
 bool gMousePressed = false;
-GLuint program_color;
-GLuint program_light;
+// draw particles as sphere impostors, see ParticleSpheres
+bool gImpostors = false;
+ShaderProgram program_color;
+ShaderProgram program_light;
+ShaderProgram program_impostor;
 
 SimpleSystem* simpleSystem;
 PendulumSystem* pendulumSystem;
@@ -78,6 +83,10 @@ static void keyCallback(GLFWwindow* window, int key,
         camera.SetCenter(Vector3f(0, 0, 0));
         break;
     }
+    case 'I':
+        gImpostors = !gImpostors;
+        cout << "Particle impostors " << (gImpostors ? "on" : "off") << endl;
+        break;
     case 'R':
     {
         cout << "Resetting simulation\n";
@@ -86,6 +95,15 @@ static void keyCallback(GLFWwindow* window, int key,
         resetTime();
         break;
     }
+    case 'T':
+    {
+        // GL state calls since the last press, see glstate.h
+        GLStateCounters counters = glStateCounters();
+        cout << "GL state calls: " << counters.issued << " issued, "
+             << counters.skipped << " skipped" << endl;
+        resetGLStateCounters();
+        break;
+    }
     default:
         cout << "Unhandled key press " << key << "." << endl;
     }
@@ -140,7 +158,7 @@ void setViewport(GLFWwindow* window)
 
 void drawAxis()
 {
-    glUseProgram(program_color);
+    useProgram(program_color.id);
     Matrix4f M = Matrix4f::translation(camera.GetCenter()).inverse();
     camera.SetUniforms(program_color, M);
 
@@ -154,7 +172,7 @@ void drawAxis()
     const Vector3f AXISY(0, 5, 0);
     const Vector3f AXISZ(0, 0, 5);
 
-    VertexRecorder recorder;
+    VertexRecorder recorder(VA_POS_COLOR);
     recorder.record_poscolor(ORGN, DKRED);
     recorder.record_poscolor(AXISX, DKRED);
     recorder.record_poscolor(ORGN, DKGREEN);
@@ -169,7 +187,7 @@ void drawAxis()
     recorder.record_poscolor(ORGN, GREY);
     recorder.record_poscolor(-AXISZ, GREY);
 
-    glLineWidth(3);
+    setLineWidth(3);
     recorder.draw(GL_LINES);
 }
 
@@ -222,7 +240,8 @@ void drawSystem()
 {
     // GLProgram wraps up all object that
     // particle systems need for drawing themselves
-    GLProgram gl(program_light, program_color, &camera);
+    GLProgram gl(program_light, program_color, &camera,
+        gImpostors ? &program_impostor : nullptr);
     gl.updateLight(LIGHT_POS, LIGHT_COLOR.xyz()); // once per frame
 
     simpleSystem->draw(gl);
@@ -233,7 +252,7 @@ void drawSystem()
     gl.updateMaterial(FLOOR_COLOR);
     gl.updateModelMatrix(Matrix4f::translation(0, -5.0f, 0));
     // draw floor
-    drawQuad(50.0f);
+    drawQuad(50.0f, gl.program(), gl.modelMatrix());
 }
 
 //-------------------------------------------------------------------
@@ -242,8 +261,8 @@ void initRendering()
 {
     // Clear to black
     glClearColor(0, 0, 0, 1);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
+    setEnabled(GL_DEPTH_TEST, true);
+    setEnabled(GL_BLEND, true);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 }
@@ -283,12 +302,17 @@ int main(int argc, char** argv)
     // of OpenGL. All OpenGL programs define a vertex shader
     // and a fragment shader.
     program_color = compileProgram(c_vertexshader, c_fragmentshader_color);
-    if (!program_color) {
+    if (!program_color.id) {
         printf("Cannot compile program\n");
         return -1;
     }
     program_light = compileProgram(c_vertexshader, c_fragmentshader_light);
-    if (!program_light) {
+    if (!program_light.id) {
+        printf("Cannot compile program\n");
+        return -1;
+    }
+    program_impostor = compileProgram(c_vertexshader, c_fragmentshader_impostor);
+    if (!program_impostor.id) {
         printf("Cannot compile program\n");
         return -1;
     }
@@ -308,6 +332,7 @@ int main(int argc, char** argv)
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         setViewport(window);
+        camera.UpdateCameraBlock();
 
         if (gMousePressed) {
             drawAxis();
@@ -319,6 +344,7 @@ int main(int argc, char** argv)
 
         // Draw the simulation
         drawSystem();
+        endStreamFrame();
 
         // Make back buffer visible
         glfwSwapBuffers(window);
@@ -329,8 +355,13 @@ int main(int argc, char** argv)
 
     // All OpenGL resource that are created with
     // glGen* or glCreate* must be freed.
-    glDeleteProgram(program_color);
-    glDeleteProgram(program_light);
+    freeSystem();
+    freePrimitives();
+    freeFrameStream();
+    camera.FreeCameraBlock();
+    glDeleteProgram(program_color.id);
+    glDeleteProgram(program_light.id);
+    glDeleteProgram(program_impostor.id);
 
 
     return 0;	// This line is never reached.
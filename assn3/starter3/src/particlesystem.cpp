@@ -2,6 +2,8 @@
 
 #include "gl.h"
 #include "camera.h"
+#include "vertexrecorder.h"
+#include "glstate.h"
 #include <random>
 #include <cstdio>
 
@@ -14,49 +16,129 @@ float rand_uniform(float low, float hi) {
    return f;
 }
 
-GLProgram::GLProgram(uint32_t apl, uint32_t apc, Camera* ac)
-    : program_light(apl), program_color(apc), camera(ac) 
+GLProgram::GLProgram(const ShaderProgram& apl, const ShaderProgram& apc, Camera* ac,
+    const ShaderProgram* api)
+    : program_light(apl), program_color(apc), camera(ac), use_impostors(api != nullptr),
+    model(Matrix4f::identity()), shininess(1.0f), alpha(1.0f), light_color(1, 1, 1)
 {
+    if (api) {
+        program_impostor = *api;
+    }
     enableLighting();
 }
 void GLProgram::updateModelMatrix(Matrix4f M) const
 {
+    model = M;
     camera->SetUniforms(active_program, M);
 }
 void GLProgram::enableLighting() {
     active_program = program_light;
-    glUseProgram(active_program);
+    useProgram(active_program.id);
 }
 void GLProgram::disableLighting() {
     active_program = program_color;
-    glUseProgram(active_program);
+    useProgram(active_program.id);
 }
 void GLProgram::updateMaterial(Vector3f diffuseColor,
     Vector3f ambientColor,
     Vector3f specularColor,
     float shininess,
     float alpha) const {
-    int loc = glGetUniformLocation(active_program, "diffColor");
-    glUniform3fv(loc, 1, diffuseColor);
     if (ambientColor.x() < 0) {
         ambientColor = 0.15f * diffuseColor;
     }
-    loc = glGetUniformLocation(active_program, "ambientColor");
-    glUniform3fv(loc, 1, ambientColor);
-    loc = glGetUniformLocation(active_program, "specColor");
-    glUniform3fv(loc, 1, specularColor);
-    loc = glGetUniformLocation(active_program, "shininess");
+    diffuse_color = diffuseColor;
+    ambient_color = ambientColor;
+    specular_color = specularColor;
+    this->shininess = shininess;
+    this->alpha = alpha;
+    setMaterial(active_program);
+}
+
+void GLProgram::setMaterial(const ShaderProgram& program) const {
+    int loc = program[U_DIFFCOLOR];
+    glUniform3fv(loc, 1, diffuse_color);
+    loc = program[U_AMBIENTCOLOR];
+    glUniform3fv(loc, 1, ambient_color);
+    loc = program[U_SPECCOLOR];
+    glUniform3fv(loc, 1, specular_color);
+    loc = program[U_SHININESS];
     glUniform1f(loc, shininess);
-    loc = glGetUniformLocation(active_program, "alpha");
+    loc = program[U_ALPHA];
     glUniform1f(loc, alpha);
 }
 
+void GLProgram::drawInstanced(VertexRecorder& rec) const {
+    rec.draw_instanced(active_program);
+}
+
+void GLProgram::drawImpostors(VertexRecorder& quads, float radius) const {
+    // a program of its own, so that the depth write and discard of the
+    // ray-cast do not cost the other lit draws their early depth test
+    useProgram(program_impostor.id);
+    camera->SetUniforms(program_impostor, model);
+    setMaterial(program_impostor);
+    setLight(program_impostor);
+    glUniform1i(program_impostor[U_IMPOSTOR], 1);
+    glUniform1f(program_impostor[U_RADIUS], radius);
+    quads.draw_instanced(program_impostor);
+    useProgram(active_program.id);
+}
+
+bool GLProgram::impostors() const {
+    return use_impostors;
+}
+
+const ShaderProgram& GLProgram::program() const {
+    return active_program;
+}
+
+const Matrix4f& GLProgram::modelMatrix() const {
+    return model;
+}
+
+ParticleSpheres::ParticleSpheres(float radius, int slices, int stacks) :
+    m_radius(radius),
+    // the particles move every frame, their instances are streamed
+    m_sphere(VA_POS_NORMAL, VU_STATIC, VU_STREAM),
+    m_quad(VA_POS, VU_STATIC, VU_STREAM)
+{
+    recordSphere(radius, slices, stacks, &m_sphere);
+    recordImpostorQuad(&m_quad);
+}
+
+void ParticleSpheres::add(const Vector3f& center) {
+    m_centers.push_back(center);
+}
+
+void ParticleSpheres::draw(const GLProgram& gl) {
+    VertexRecorder& rec = gl.impostors() ? m_quad : m_sphere;
+    rec.clear_instances();
+    for (const Vector3f& center : m_centers) {
+        rec.record_instance(Matrix4f::translation(center));
+    }
+    m_centers.clear();
+
+    gl.updateModelMatrix(Matrix4f::identity());
+    if (gl.impostors()) {
+        gl.drawImpostors(rec, m_radius);
+    } else {
+        gl.drawInstanced(rec);
+    }
+}
+
 void GLProgram::updateLight(Vector3f pos, Vector3f color) const {
-    int loc = glGetUniformLocation(active_program, "lightPos");
-    glUniform3fv(loc, 1, pos);
+    light_pos = pos;
+    light_color = color;
+    setLight(active_program);
+}
+
+void GLProgram::setLight(const ShaderProgram& program) const {
+    int loc = program[U_LIGHTPOS];
+    glUniform3fv(loc, 1, light_pos);
 
-    loc = glGetUniformLocation(active_program, "lightDiff");
-    glUniform3fv(loc, 1, color);
+    loc = program[U_LIGHTDIFF];
+    glUniform3fv(loc, 1, light_color);
 }
 
 
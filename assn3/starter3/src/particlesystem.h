@@ -4,11 +4,17 @@
 #include <vector>
 #include <vecmath.h>
 #include <cstdint>
+#include "starter3_util.h"
+#include "vertexrecorder.h"
 
 
 // helper for uniform distribution
 float rand_uniform(float low, float hi);
 
+// The systems integrate their state in double precision, so that long
+// simulations do not drift; rendering converts to Vector3f.
+typedef Vector3d StateVector;
+
 struct GLProgram;
 class ParticleSystem
 {
@@ -16,16 +22,16 @@ public:
     virtual ~ParticleSystem() {}
 
     // for a given state, evaluate derivative f(X,t)
-    virtual std::vector<Vector3f> evalF(std::vector<Vector3f> state) = 0;
+    virtual std::vector<StateVector> evalF(std::vector<StateVector> state) = 0;
 
     // getter method for the system's state
-    std::vector<Vector3f> getState() { return m_vVecState; };
+    std::vector<StateVector> getState() { return m_vVecState; };
 
     // setter method for the system's state
-    void setState(const std::vector<Vector3f>  & newState) { m_vVecState = newState; };
+    void setState(const std::vector<StateVector>  & newState) { m_vVecState = newState; };
 
  protected:
-    std::vector<Vector3f> m_vVecState;
+    std::vector<StateVector> m_vVecState;
 };
 
 /* GLProgram is a helper for updating uniform variables.
@@ -36,8 +42,10 @@ public:
 */
 class Camera;
 struct GLProgram {
-    // constructor
-    GLProgram(uint32_t program_light, uint32_t program_color, Camera* camera);
+    // constructor. If program_impostor is given, ParticleSpheres are
+    // drawn as impostors with it instead of tessellated spheres.
+    GLProgram(const ShaderProgram& program_light, const ShaderProgram& program_color, Camera* camera,
+        const ShaderProgram* program_impostor = nullptr);
 
     // Update the model matrix. View and projection matrix
     // are read from the camera.
@@ -59,11 +67,66 @@ struct GLProgram {
     void enableLighting();
     void disableLighting();
 
+    // Draw the instances recorded in rec with the active program.
+    // Each instance's model matrix is applied before the one set by
+    // updateModelMatrix().
+    void drawInstanced(VertexRecorder& rec) const;
+
+    // Draw a sphere of the given radius around the origin of each
+    // instance recorded in quads, which must hold recordImpostorQuad().
+    // Each sphere is one quad whose fragment shader ray-casts the sphere
+    // and writes its depth. The draw switches to program_impostor with
+    // the model matrix, material and light set so far, and back.
+    void drawImpostors(VertexRecorder& quads, float radius) const;
+    bool impostors() const;
+
+    // the active program and the model matrix last set on it, e.g. for
+    // drawSphere()
+    const ShaderProgram& program() const;
+    const Matrix4f& modelMatrix() const;
+
 private:
+    void setMaterial(const ShaderProgram& program) const;
+    void setLight(const ShaderProgram& program) const;
+
     // member variables
-    uint32_t active_program;
-    uint32_t program_light;
-    uint32_t program_color;
+    ShaderProgram active_program;
+    ShaderProgram program_light;
+    ShaderProgram program_color;
+    ShaderProgram program_impostor;
     const Camera* camera;
+    bool use_impostors;
+
+    // the latest uniforms, which drawImpostors() copies to program_impostor
+    mutable Matrix4f model;
+    mutable Vector3f diffuse_color;
+    mutable Vector3f ambient_color;
+    mutable Vector3f specular_color;
+    mutable float shininess;
+    mutable float alpha;
+    mutable Vector3f light_pos;
+    mutable Vector3f light_color;
+};
+
+/* The particles of a system, drawn as spheres of one radius in a single
+   instanced draw call: tessellated, or as impostors if GLProgram asks
+   for them. Impostors cost four vertices per particle however fine the
+   sphere is, which pays off for large particle counts.
+*/
+class ParticleSpheres {
+public:
+    // slices and stacks are the detail of the tessellated sphere
+    ParticleSpheres(float radius, int slices, int stacks);
+
+    // add a particle to the next draw()
+    void add(const Vector3f& center);
+    // draw the particles added since the last draw()
+    void draw(const GLProgram& gl);
+
+private:
+    float m_radius;
+    std::vector<Vector3f> m_centers;
+    VertexRecorder m_sphere;
+    VertexRecorder m_quad;
 };
 #endif
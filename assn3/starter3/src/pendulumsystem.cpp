@@ -13,9 +13,10 @@ const int NUM_PARTICLES = 5;
 const float VISCOUS_K = 0.1;
 const float SPRING_K = 4.0;
 const float SPRING_LENGTH = 0.1;
-const Vector3f g = Vector3f(0.0, -9.81, 0.0);
+const StateVector g = StateVector(0.0, -9.81, 0.0);
 
-PendulumSystem::PendulumSystem()
+PendulumSystem::PendulumSystem() :
+    m_particles(0.075f, 10, 10)
 {
 
     // TODO 4.2 Add particles for simple pendulum
@@ -36,41 +37,41 @@ PendulumSystem::PendulumSystem()
             // y = m_vVecState[2 * (i - 1)][1] - rand_uniform(0.1, 0.5);
             y = m_vVecState[2 * (i - 1)][1] - rand_uniform(0.1, 0.3);
         }
-        m_vVecState.push_back(Vector3f(rand_uniform(-0.1, 0.1), y, rand_uniform(-0.1, 0.1)));  // positions
-        m_vVecState.push_back(Vector3f(0.0, 0.0, 0.0));  // velocities
+        m_vVecState.push_back(StateVector(rand_uniform(-0.1, 0.1), y, rand_uniform(-0.1, 0.1)));  // positions
+        m_vVecState.push_back(StateVector(0.0, 0.0, 0.0));  // velocities
     }
 }
 
 
-std::vector<Vector3f> PendulumSystem::evalF(std::vector<Vector3f> state)
+std::vector<StateVector> PendulumSystem::evalF(std::vector<StateVector> state)
 {
-    std::vector<Vector3f> f;
+    std::vector<StateVector> f;
 
     // TODO 4.1: implement evalF
     //  - gravity
-    std::vector<Vector3f> forcesGravity(NUM_PARTICLES);
+    std::vector<StateVector> forcesGravity(NUM_PARTICLES);
     for (size_t i = 0; i < NUM_PARTICLES; ++i) {
         forcesGravity[i] = m_masses[i] * g;
     }
 
     //  - viscous drag
-    std::vector<Vector3f> forcesViscous(NUM_PARTICLES);
+    std::vector<StateVector> forcesViscous(NUM_PARTICLES);
     for (size_t i = 0; i < NUM_PARTICLES; ++i) {
         forcesViscous[i] = -m_viscous_k * state[2 * i + 1];
     }
 
     //  - springs
-    std::vector<Vector3f> forcesSpring(NUM_PARTICLES);
+    std::vector<StateVector> forcesSpring(NUM_PARTICLES);
     for (size_t i = 0; i < NUM_PARTICLES; ++i) {
-        Vector3f forceSpring(0.0, 0.0, 0.0);
+        StateVector forceSpring(0.0, 0.0, 0.0);
 
         if (i > 0) {
-            Vector3f d = state[2 * i] - state[2 * (i - 1)];
+            StateVector d = state[2 * i] - state[2 * (i - 1)];
             forceSpring += -m_spring_k * (d.abs() - m_spring_length) * (d / (EPS + d.abs()));
         }
 
         if (i < NUM_PARTICLES - 1) {
-            Vector3f d = state[2 * i] - state[2 * (i + 1)];
+            StateVector d = state[2 * i] - state[2 * (i + 1)];
             forceSpring += -m_spring_k * (d.abs() - m_spring_length) * (d / (EPS + d.abs()));
         }
         // if (isnan(-m_spring_k * (d.abs() - m_spring_length) * (d / (EPS + d.abs())))) {
@@ -81,7 +82,7 @@ std::vector<Vector3f> PendulumSystem::evalF(std::vector<Vector3f> state)
     }
     
     // sum up all
-    std::vector<Vector3f> accelerations(NUM_PARTICLES);
+    std::vector<StateVector> accelerations(NUM_PARTICLES);
     for (size_t i = 0; i < NUM_PARTICLES; ++i) {
         accelerations[i] = (forcesGravity[i] + forcesViscous[i] + forcesSpring[i]) / m_masses[i];
         if (i == 0) {
@@ -109,7 +110,7 @@ void PendulumSystem::draw(GLProgram& gl)
 
     // example code. Replace with your own drawing  code
     for (size_t i = 0; i < NUM_PARTICLES; ++i) {
-        gl.updateModelMatrix(Matrix4f::translation(m_vVecState[2 * i]));
-        drawSphere(0.075f, 10, 10);
+        m_particles.add(Vector3f(m_vVecState[2 * i]));
     }
+    m_particles.draw(gl);
 }
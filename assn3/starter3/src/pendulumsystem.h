@@ -4,22 +4,26 @@
 #include <vector>
 
 #include "particlesystem.h"
+#include "vertexrecorder.h"
 
 class PendulumSystem : public ParticleSystem
 {
 public:
     PendulumSystem();
 
-    std::vector<Vector3f> evalF(std::vector<Vector3f> state) override;
+    std::vector<StateVector> evalF(std::vector<StateVector> state) override;
     void draw(GLProgram&);
 
     // inherits 
-    // std::vector<Vector3f> m_vVecState;
+    // std::vector<StateVector> m_vVecState;
 private:
     std::vector<float> m_masses;
     float m_viscous_k;
     float m_spring_k;
     float m_spring_length;
+
+    // a sphere at every particle
+    ParticleSpheres m_particles;
 };
 
 #endif
@@ -4,19 +4,20 @@
 #include "vertexrecorder.h"
 
 
-SimpleSystem::SimpleSystem()
+SimpleSystem::SimpleSystem() :
+    m_particle(0.075f, 10, 10)
 {
     // TODO 3.2 initialize the simple system
-    m_vVecState.push_back(Vector3f(1.0, 1.0, 0.0));
+    m_vVecState.push_back(StateVector(1.0, 1.0, 0.0));
 }
 
-std::vector<Vector3f> SimpleSystem::evalF(std::vector<Vector3f> state)
+std::vector<StateVector> SimpleSystem::evalF(std::vector<StateVector> state)
 {
-    std::vector<Vector3f> f;
+    std::vector<StateVector> f;
 
     // TODO 3.2: implement evalF
     // for a given state, evaluate f(X,t)
-    Vector3f fCoordinates = Vector3f(-state[0][1], state[0][0], state[0][2]);
+    StateVector fCoordinates = StateVector(-state[0][1], state[0][0], state[0][2]);
     f.push_back(fCoordinates);
 
     return f;
@@ -40,6 +41,6 @@ void SimpleSystem::draw(GLProgram& gl)
     const Vector3f PARTICLE_COLOR(0.4f, 0.7f, 1.0f);
     gl.updateMaterial(PARTICLE_COLOR);
     Vector3f pos(getState()[0]); //YOUR PARTICLE POSITION
-    gl.updateModelMatrix(Matrix4f::translation(pos));
-    drawSphere(0.075f, 10, 10);
+    m_particle.add(pos);
+    m_particle.draw(gl);
 }
@@ -14,13 +14,15 @@ public:
     // with any particle system (simple, pendulum, cloth), without
     // knowing which particular system it is.
     // Each ParticleSystem subclass must provide an implementation of evalF.
-    std::vector<Vector3f> evalF(std::vector<Vector3f> state) override;
+    std::vector<StateVector> evalF(std::vector<StateVector> state) override;
 
     // this is called from main.cpp when it's time to draw a new frame.
     void draw(GLProgram&);
 
     // inherits 
-    // std::vector<Vector3f> m_vVecState;
+    // std::vector<StateVector> m_vVecState;
+private:
+    ParticleSpheres m_particle;
 };
 
 #endif
@@ -11,9 +11,42 @@ struct GLFWwindow;
 // creates a window using GLFW and initializes an OpenGL 3.3+ context.
 GLFWwindow* createOpenGLWindow(int width, int height, const char* title);
 
-// returns 0 on error
-// program must be freed with glDeleteProgram()
-uint32_t compileProgram(const char* vertexshader, const char* fragmentshader);
+// Uniform buffer binding of CameraBlock, which compileProgram() assigns
+// to every program.
+const uint32_t CAMERA_BLOCK_BINDING = 1;
+
+// Uniforms of the shaders below, except the ones in CameraBlock.
+enum Uniform {
+    U_M,
+    U_N,
+    U_DIFFCOLOR,
+    U_SPECCOLOR,
+    U_AMBIENTCOLOR,
+    U_SHININESS,
+    U_ALPHA,
+    U_LIGHTPOS,
+    U_LIGHTDIFF,
+    U_INSTANCED,
+    U_IMPOSTOR,
+    U_RADIUS,
+    U_COUNT
+};
+
+// A linked program together with the locations of its uniforms,
+// which are looked up once when the program is compiled.
+struct ShaderProgram {
+    ShaderProgram();
+
+    uint32_t id;
+    // location of each Uniform, -1 if the program does not use it
+    int location[U_COUNT];
+
+    int operator[](Uniform u) const { return location[u]; }
+};
+
+// returns a program with id 0 on error
+// program.id must be freed with glDeleteProgram()
+ShaderProgram compileProgram(const char* vertexshader, const char* fragmentshader);
 
 static const char* c_vertexshader = R"RAWSTR(
 #version 330
@@ -24,27 +57,69 @@ layout(location=0) in vec3 Position;
 layout(location=1) in vec3 Normal;
 layout(location=2) in vec3 Color;
 
-uniform mat4 P;
-uniform mat4 V;
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
 uniform mat4 M;
 uniform mat4 N;
 
+// Per-instance model matrix and color, read when instanced is set,
+// see VertexRecorder::draw_instanced().
+layout(location=3) in vec4 InstanceColor;
+layout(location=4) in mat4 InstanceM;
+uniform bool instanced;
+
+// Sphere impostors, see GLProgram::drawImpostors(). The recording is a
+// quad with corners (+-1, +-1, 0), which is turned towards the camera
+// and scaled to cover the sphere of this radius around the origin of
+// the model matrix. Only set with c_fragmentshader_impostor.
+uniform bool impostor;
+uniform float radius;
+
 // var_ (varying) variables are output in the vertex
 // shader and are interpolated by the GPU for each
 // pixel of the triangle.
 out vec3 var_Position;
 out vec3 var_Normal;
 out vec4 var_Color;
+flat out vec3 var_Center;
 
 void main () {
+    // instances apply their model matrix before M
+    mat4 model = M;
+    mat3 normal_instance = mat3(1);
+    var_Color = vec4(Color, 1);
+    if (instanced) {
+        model = M * InstanceM;
+        normal_instance = transpose(inverse(mat3(InstanceM)));
+        var_Color = InstanceColor;
+    }
+
     // Simple pass-through vertex shader
-    gl_Position = P * V * M * vec4(Position, 1);
-    vec4 position_world = M * vec4(Position, 1);
+    vec4 position_world = model * vec4(Position, 1);
+    var_Center = vec3(0);
+    if (impostor) {
+        vec3 center = (model * vec4(0, 0, 0, 1)).xyz;
+        vec3 to_cam = camPos - center;
+        float d = length(to_cam);
+        to_cam /= d;
+        // the camera's up direction is the second row of V
+        vec3 up = vec3(V[0][1], V[1][1], V[2][1]);
+        vec3 right = normalize(cross(up, to_cam));
+        up = cross(to_cam, right);
+        // in perspective the silhouette is wider than the radius
+        float size = radius * d / sqrt(max(d * d - radius * radius, 1e-6));
+        position_world = vec4(center + size * (Position.x * right + Position.y * up), 1);
+        var_Center = center;
+    }
+    gl_Position = P * V * position_world;
     var_Position = position_world.xyz / position_world.w;
 
-    vec3 normal_world = (N * vec4(Normal, 1)).xyz;
+    vec3 normal_world = (N * vec4(normal_instance * Normal, 1)).xyz;
     var_Normal = normalize(normal_world);
-    var_Color = vec4(Color, 1);
 }
 )RAWSTR";
 static const char* c_fragmentshader_color = R"RAWSTR(
@@ -66,13 +141,19 @@ in vec4 var_Color;
 in vec3 var_Normal;
 in vec3 var_Position;
 
-uniform vec3 camPos;
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
 
 uniform vec3 diffColor;
 uniform vec3 specColor;
 uniform vec3 ambientColor;
 uniform float shininess;
 uniform float alpha;
+uniform bool instanced;
 
 uniform vec3 lightPos;
 uniform vec3 lightDiff;
@@ -96,8 +177,10 @@ vec4 blinn_phong() {
     cam_dir = normalize(cam_dir);
 
     // 2. Compute Diffuse Contribution
+    // (instances tint the diffuse color with their own color)
+    vec3 kd = instanced ? diffColor * var_Color.rgb : diffColor;
     float ndotl = max(dot(normal_world, light_dir), 0.0);
-    vec3 diffContrib = PI_INV * lightDiff * diffColor
+    vec3 diffContrib = PI_INV * lightDiff * kd
                        * ndotl / distsq;
 
     // 3. Compute Specular Contribution
@@ -115,4 +198,74 @@ void main () {
 }
 )RAWSTR";
 
+// Sphere impostors, see GLProgram::drawImpostors(). Kept apart from
+// c_fragmentshader_light because writing gl_FragDepth and discarding
+// disable the early depth test for every draw of the program.
+static const char* c_fragmentshader_impostor = R"RAWSTR(
+#version 330
+in vec4 var_Color;
+in vec3 var_Position;
+flat in vec3 var_Center;
+
+// camera, shared by all programs (Camera::UpdateCameraBlock)
+layout(std140) uniform CameraBlock {
+    mat4 P;
+    mat4 V;
+    vec3 camPos;
+};
+
+uniform vec3 diffColor;
+uniform vec3 specColor;
+uniform vec3 ambientColor;
+uniform float shininess;
+uniform float alpha;
+uniform bool instanced;
+uniform float radius;
+
+uniform vec3 lightPos;
+uniform vec3 lightDiff;
+
+layout(location=0) out vec4 out_Color;
+
+#define PI_INV 0.318309886183791
+
+// same shading as c_fragmentshader_light, at a given point
+vec4 blinn_phong(vec3 pos_world, vec3 normal_world) {
+    vec3 light_dir = lightPos - pos_world;
+    vec3 cam_dir = camPos - pos_world;
+    float distsq = dot(light_dir, light_dir);
+    light_dir = normalize(light_dir);
+    cam_dir = normalize(cam_dir);
+
+    vec3 kd = instanced ? diffColor * var_Color.rgb : diffColor;
+    float ndotl = max(dot(normal_world, light_dir), 0.0);
+    vec3 diffContrib = PI_INV * lightDiff * kd
+                       * ndotl / distsq;
+
+    vec3 R = reflect( -light_dir, normal_world );
+    float eyedotr = max(dot(cam_dir, R), 0.0);
+    vec3 specContrib = pow(eyedotr, shininess) *
+                       specColor * lightDiff / distsq;
+
+    return  + vec4(ambientColor + diffContrib + specContrib, alpha);
+}
+
+void main () {
+    // intersect the ray from the camera through this fragment
+    // with the sphere, and take the depth of the hit point
+    vec3 dir = normalize(var_Position - camPos);
+    vec3 oc = camPos - var_Center;
+    float b = dot(dir, oc);
+    float disc = b * b - dot(oc, oc) + radius * radius;
+    if (disc < 0.0) {
+        discard;
+    }
+    vec3 position = camPos + (-b - sqrt(disc)) * dir;
+    vec3 normal = (position - var_Center) / radius;
+    vec4 clip = P * V * vec4(position, 1);
+    gl_FragDepth = 0.5 * clip.z / clip.w + 0.5;
+    out_Color = blinn_phong(position, normal);
+}
+)RAWSTR";
+
 #endif
@@ -0,0 +1,67 @@
+#ifndef STREAMBUFFER_H
+#define STREAMBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include "gl.h"
+
+// A ring buffer for vertex data that is recorded again every frame.
+// Each write() copies into the next free range of one large GL buffer
+// through an unsynchronized map, so the driver never waits for the GPU
+// and no buffer is created or resized after the first frame. The ranges
+// written in a frame are fenced by endFrame(), and a range is only
+// written again once the GPU has passed its fence.
+class StreamBuffer {
+public:
+    // size is the capacity in bytes. It should hold a few frames of data
+    // so that write() does not have to wait for the GPU.
+    explicit StreamBuffer(size_t size);
+    // deletes the GL buffer and the pending fences
+    ~StreamBuffer();
+    // owns GL objects, so it cannot be copied
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // copies nbytes (at most size()) into the ring and returns their
+    // offset in buffer(). The data stays valid until the end of the
+    // frame, as long as the frame writes less than size() in total.
+    size_t write(const void* data, size_t nbytes);
+    // fences the data written since the last call. Call once per frame,
+    // after the last draw that reads from the buffer.
+    void endFrame();
+
+    uint32_t buffer() const;
+    size_t size() const;
+    // number of endFrame() calls, to tell whether data is from this frame
+    uint64_t frame() const;
+private:
+    // fences the range written since the last fence
+    void fence();
+    // waits for and releases the fences of ranges overlapping [begin, end)
+    void reclaim(size_t begin, size_t end);
+
+    // a range written in earlier frames that the GPU may still read
+    struct Range {
+        size_t begin;
+        size_t end;
+        GLsync fence;
+    };
+
+    size_t m_size;
+    size_t m_head; // end of the last write
+    size_t m_framebegin; // start of the unfenced range written this frame
+    uint64_t m_frame;
+    uint32_t m_buffer; // created on the first write
+    std::deque<Range> m_pending; // oldest first
+};
+
+// The stream shared by all VU_STREAM recorders, created on first use.
+StreamBuffer& frameStream();
+// Fences this frame's writes to frameStream(). Call after the last draw
+// of every frame, before swapping buffers.
+void endStreamFrame();
+// Deletes frameStream(); call before the GL context is destroyed.
+void freeFrameStream();
+
+#endif
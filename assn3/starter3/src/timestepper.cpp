@@ -2,88 +2,57 @@
 
 #include <cstdio>
 
+#include "VectorExpr.h"
+
+// fused element-wise updates of the state vectors, see vecmath/include/VectorExpr.h
+using namespace vecmath_expr;
+
 void ForwardEuler::takeStep(ParticleSystem* particleSystem, float stepSize)
 {
    //TODO: See handout 3.1
-   std::vector<Vector3f> state = particleSystem->getState();
-   std::vector<Vector3f> f = particleSystem->evalF(state);
+   std::vector<StateVector> state = particleSystem->getState();
+   std::vector<StateVector> f = particleSystem->evalF(state);
 
-   std::vector<Vector3f> newState;
-   for (size_t i = 0; i < state.size(); ++i) {
-      newState.push_back(state[i] + stepSize * f[i]);
-   }
+   evaluate(state, expr(state) + stepSize * expr(f));
 
-   particleSystem->setState(newState);
+   particleSystem->setState(state);
 }
 
 void Trapezoidal::takeStep(ParticleSystem* particleSystem, float stepSize)
 {
    //TODO: See handout 3.1
-   std::vector<Vector3f> state = particleSystem->getState();
-   std::vector<Vector3f> f0 = particleSystem->evalF(state);
-   size_t stateSize = state.size();
-   std::vector<Vector3f> movedState;
-   for (size_t i = 0; i < stateSize; ++i) {
-      movedState.push_back(state[i] + stepSize * f0[i]);
-   }
-
-   std::vector<Vector3f> f1 = particleSystem->evalF(movedState);
-   std::vector<Vector3f> newState;
-   for (size_t i = 0; i < state.size(); ++i) {
-      newState.push_back(state[i] + (stepSize / 2.0) * (f0[i] + f1[i]));
-   }
-
-   particleSystem->setState(newState);
+   std::vector<StateVector> state = particleSystem->getState();
+   std::vector<StateVector> f0 = particleSystem->evalF(state);
+   std::vector<StateVector> movedState;
+   evaluate(movedState, expr(state) + stepSize * expr(f0));
+
+   std::vector<StateVector> f1 = particleSystem->evalF(movedState);
+   evaluate(state, expr(state) + (stepSize / 2.0f) * (expr(f0) + expr(f1)));
+
+   particleSystem->setState(state);
 }
 
 
+// The k_i are the unscaled derivatives here; stepSize is folded into the
+// coefficients of each fused update instead of scaling every k_i in place.
 void RK4::takeStep(ParticleSystem* particleSystem, float stepSize)
 {
-   std::vector<Vector3f> state = particleSystem->getState();
-   size_t stateSize = state.size();
-   
-   // k1
-   std::vector<Vector3f> k1 = particleSystem->evalF(state);
-   for (size_t i = 0; i < stateSize; ++i) {
-      k1[i] *= stepSize;
-   }
-
-   // k2
-   std::vector<Vector3f> k2Input;
-   for (size_t i = 0; i < stateSize; ++i) {
-      k2Input.push_back(state[i] + 0.5 * k1[i]);
-   }
-   std::vector<Vector3f> k2 = particleSystem->evalF(k2Input);
-   for (size_t i = 0; i < stateSize; ++i) {
-      k2[i] *= stepSize;
-   }
-
-   // k3
-   std::vector<Vector3f> k3Input;
-   for (size_t i = 0; i < stateSize; ++i) {
-      k3Input.push_back(state[i] + 0.5 * k2[i]);
-   }
-   std::vector<Vector3f> k3 = particleSystem->evalF(k3Input);
-   for (size_t i = 0; i < stateSize; ++i) {
-      k3[i] *= stepSize;
-   }
-
-   // k4
-   std::vector<Vector3f> k4Input;
-   for (size_t i = 0; i < stateSize; ++i) {
-      k4Input.push_back(state[i] + k3[i]);
-   }
-   std::vector<Vector3f> k4 = particleSystem->evalF(k4Input);
-   for (size_t i = 0; i < stateSize; ++i) {
-      k4[i] *= stepSize;
-   }
+   std::vector<StateVector> state = particleSystem->getState();
+   std::vector<StateVector> input;
+
+   std::vector<StateVector> k1 = particleSystem->evalF(state);
+
+   evaluate(input, expr(state) + (0.5f * stepSize) * expr(k1));
+   std::vector<StateVector> k2 = particleSystem->evalF(input);
+
+   evaluate(input, expr(state) + (0.5f * stepSize) * expr(k2));
+   std::vector<StateVector> k3 = particleSystem->evalF(input);
+
+   evaluate(input, expr(state) + stepSize * expr(k3));
+   std::vector<StateVector> k4 = particleSystem->evalF(input);
 
    // update state
-   std::vector<Vector3f> newState;
-   for (size_t i = 0; i < state.size(); ++i) {
-      newState.push_back(state[i] + (1.0 / 6.0) * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]));
-   }
+   evaluate(state, expr(state) + (stepSize / 6.0f) * (expr(k1) + 2 * expr(k2) + 2 * expr(k3) + expr(k4)));
 
-   particleSystem->setState(newState);
+   particleSystem->setState(state);
 }
-
@@ -0,0 +1,2 @@
+#include "Affine3f.h"
+#include "Affine3f.inl"
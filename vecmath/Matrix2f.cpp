@@ -0,0 +1,2 @@
+#include "Matrix2f.h"
+#include "Matrix2f.inl"
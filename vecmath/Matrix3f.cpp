@@ -0,0 +1,2 @@
+#include "Matrix3f.h"
+#include "Matrix3f.inl"
@@ -0,0 +1,17 @@
+#include "Matrix4f.h"
+#include "Matrix4f.inl"
+
+//////////////////////////////////////////////////////////////////////////
+// Instantiations
+//////////////////////////////////////////////////////////////////////////
+
+// see Vector3f.cpp
+#define VECMATH_INSTANTIATE_MATRIX4( T ) \
+	template class Matrix4< T >; \
+	template Vector4f operator * ( const Matrix4< T >& m, const Vector4f& v ); \
+	template Matrix4< T > operator * ( const Matrix4< T >& x, const Matrix4< T >& y ); \
+	template Matrix4< T > operator * ( const Matrix4< T >& m, T f ); \
+	template Matrix4< T > operator * ( T f, const Matrix4< T >& m );
+
+VECMATH_INSTANTIATE_MATRIX4( float )
+VECMATH_INSTANTIATE_MATRIX4( double )
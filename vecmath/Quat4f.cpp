@@ -0,0 +1,30 @@
+#include "Quat4f.h"
+#include "Quat4f.inl"
+
+//////////////////////////////////////////////////////////////////////////
+// Static constants
+//////////////////////////////////////////////////////////////////////////
+
+// static
+template< typename T >
+const Quat4< T > Quat4< T >::ZERO = Quat4< T >( 0, 0, 0, 0 );
+
+// static
+template< typename T >
+const Quat4< T > Quat4< T >::IDENTITY = Quat4< T >( 1, 0, 0, 0 );
+
+//////////////////////////////////////////////////////////////////////////
+// Instantiations
+//////////////////////////////////////////////////////////////////////////
+
+// see Vector3f.cpp
+#define VECMATH_INSTANTIATE_QUAT4( T ) \
+	template class Quat4< T >; \
+	template Quat4< T > operator + ( const Quat4< T >& q0, const Quat4< T >& q1 ); \
+	template Quat4< T > operator - ( const Quat4< T >& q0, const Quat4< T >& q1 ); \
+	template Quat4< T > operator * ( const Quat4< T >& q0, const Quat4< T >& q1 ); \
+	template Quat4< T > operator * ( T f, const Quat4< T >& q ); \
+	template Quat4< T > operator * ( const Quat4< T >& q, T f );
+
+VECMATH_INSTANTIATE_QUAT4( float )
+VECMATH_INSTANTIATE_QUAT4( double )
@@ -0,0 +1,2 @@
+#include "Trig.h"
+#include "Trig.inl"
@@ -0,0 +1,15 @@
+#include "Vector2f.h"
+#include "Vector2f.inl"
+
+//////////////////////////////////////////////////////////////////////////
+// Static constants
+//////////////////////////////////////////////////////////////////////////
+
+// static
+const Vector2f Vector2f::ZERO = Vector2f( 0, 0 );
+
+// static
+const Vector2f Vector2f::UP = Vector2f( 0, 1 );
+
+// static
+const Vector2f Vector2f::RIGHT = Vector2f( 1, 0 );
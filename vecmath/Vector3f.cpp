@@ -0,0 +1,44 @@
+#include "Vector3f.h"
+#include "Vector3f.inl"
+
+//////////////////////////////////////////////////////////////////////////
+// Static constants
+//////////////////////////////////////////////////////////////////////////
+
+// static
+template< typename T >
+const Vector3< T > Vector3< T >::ZERO = Vector3< T >( 0, 0, 0 );
+
+// static
+template< typename T >
+const Vector3< T > Vector3< T >::UP = Vector3< T >( 0, 1, 0 );
+
+// static
+template< typename T >
+const Vector3< T > Vector3< T >::RIGHT = Vector3< T >( 1, 0, 0 );
+
+// static
+template< typename T >
+const Vector3< T > Vector3< T >::FORWARD = Vector3< T >( 0, 0, -1 );
+
+//////////////////////////////////////////////////////////////////////////
+// Instantiations
+//////////////////////////////////////////////////////////////////////////
+
+// Without VECMATH_HEADER_ONLY, code using Vector3f and Vector3d links
+// against these. They also provide the static constants in both modes.
+#define VECMATH_INSTANTIATE_VECTOR3( T ) \
+	template class Vector3< T >; \
+	template Vector3< T > operator + ( const Vector3< T >& v0, const Vector3< T >& v1 ); \
+	template Vector3< T > operator - ( const Vector3< T >& v0, const Vector3< T >& v1 ); \
+	template Vector3< T > operator * ( const Vector3< T >& v0, const Vector3< T >& v1 ); \
+	template Vector3< T > operator / ( const Vector3< T >& v0, const Vector3< T >& v1 ); \
+	template Vector3< T > operator - ( const Vector3< T >& v ); \
+	template Vector3< T > operator * ( T f, const Vector3< T >& v ); \
+	template Vector3< T > operator * ( const Vector3< T >& v, T f ); \
+	template Vector3< T > operator / ( const Vector3< T >& v, T f ); \
+	template bool operator == ( const Vector3< T >& v0, const Vector3< T >& v1 ); \
+	template bool operator != ( const Vector3< T >& v0, const Vector3< T >& v1 );
+
+VECMATH_INSTANTIATE_VECTOR3( float )
+VECMATH_INSTANTIATE_VECTOR3( double )
@@ -0,0 +1,2 @@
+#include "Vector3fArray.h"
+#include "Vector3fArray.inl"
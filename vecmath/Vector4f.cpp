@@ -0,0 +1,2 @@
+#include "Vector4f.h"
+#include "Vector4f.inl"
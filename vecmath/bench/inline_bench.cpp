@@ -0,0 +1,199 @@
+// Times the two vecmath-heavy inner loops of the assignments, the cloth
+// spring forces (assn3 ClothSystem::evalF) and linear blend skinning
+// (assn2 SkeletalModel::updateMesh), so that the default build and the
+// VECMATH_HEADER_ONLY build can be compared. Configure once with
+// -DVECMATH_HEADER_ONLY=OFF and once with =ON and compare the output.
+// The cloth loop runs once with Vector3f and once with Vector3d state, to
+// show the cost of simulating in double precision.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "vecmath.h"
+
+namespace
+{
+
+const int CLOTH_W = 32;
+const int CLOTH_H = 32;
+const int CLOTH_ITERATIONS = 2000;
+
+const int SKIN_VERTICES = 5000;
+const int SKIN_JOINTS = 18;
+const int SKIN_ITERATIONS = 200;
+
+float randUniform( float lo, float hi )
+{
+	return lo + ( hi - lo ) * ( float )rand() / RAND_MAX;
+}
+
+int indexOf( int i, int j )
+{
+	return i * CLOTH_W + j;
+}
+
+// Same structure as SkeletalModel::updateMesh.
+void skin( const std::vector< Vector3f >& bindVertices,
+	const std::vector< std::vector< float > >& attachments,
+	const std::vector< Matrix4f >& jointToWorld,
+	const std::vector< Matrix4f >& bindWorldToJoint,
+	std::vector< Vector3f >& currentVertices )
+{
+	for( size_t i = 0; i < bindVertices.size(); ++i )
+	{
+		Vector4f bindVertex( bindVertices[ i ], 1.0f );
+		Vector3f v( 0.0f, 0.0f, 0.0f );
+		for( size_t j = 0; j < jointToWorld.size(); ++j )
+		{
+			v += attachments[ i ][ j ] * ( jointToWorld[ j ] * bindWorldToJoint[ j ] * bindVertex ).xyz();
+		}
+		currentVertices[ i ] = v;
+	}
+}
+
+template< typename F >
+double timeMs( F f )
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration< double, std::milli >( end - start ).count();
+}
+
+template< typename T >
+Vector3< T > springForce( const Vector3< T >& a, const Vector3< T >& b, T k, T restLength )
+{
+	Vector3< T > d = a - b;
+	return -k * ( d.abs() - restLength ) * ( d / ( T( 1e-6 ) + d.abs() ) );
+}
+
+// Same structure as ClothSystem::evalF: state holds (position, velocity)
+// pairs, forces are gravity, drag and structural/shear/flexion springs.
+template< typename T >
+std::vector< Vector3< T > > clothEvalF( const std::vector< Vector3< T > >& state )
+{
+	const Vector3< T > gravity( 0, T( -9.81 ), 0 );
+	const int offsets[ 12 ][ 3 ] = {
+		// di, dj, spring type
+		{ -1, 0, 0 }, { 0, -1, 0 }, { 1, 0, 0 }, { 0, 1, 0 },
+		{ 1, 1, 1 }, { 1, -1, 1 }, { -1, 1, 1 }, { -1, -1, 1 },
+		{ -2, 0, 2 }, { 0, -2, 2 }, { 2, 0, 2 }, { 0, 2, 2 }
+	};
+	const T k[ 3 ] = { 50, 2, 2 };
+	const T restLength[ 3 ] = { T( 0.2 ), T( 0.28 ), T( 0.4 ) };
+
+	std::vector< Vector3< T > > f( state.size() );
+	for( int i = 0; i < CLOTH_H; ++i )
+	{
+		for( int j = 0; j < CLOTH_W; ++j )
+		{
+			int p = indexOf( i, j );
+			Vector3< T > force = T( 0.01 ) * gravity - T( 0.1 ) * state[ 2 * p + 1 ];
+			for( int s = 0; s < 12; ++s )
+			{
+				int ni = i + offsets[ s ][ 0 ];
+				int nj = j + offsets[ s ][ 1 ];
+				if( ni < 0 || ni >= CLOTH_H || nj < 0 || nj >= CLOTH_W )
+				{
+					continue;
+				}
+				int type = offsets[ s ][ 2 ];
+				force += springForce( state[ 2 * p ], state[ 2 * indexOf( ni, nj ) ], k[ type ], restLength[ type ] );
+			}
+			f[ 2 * p ] = state[ 2 * p + 1 ];
+			f[ 2 * p + 1 ] = force / T( 0.01 );
+		}
+	}
+	return f;
+}
+
+// Runs CLOTH_ITERATIONS explicit Euler steps, which keep the loop
+// data-dependent, and returns the time in ms. state is the final state.
+template< typename T >
+double clothMs( std::vector< Vector3< T > >& state )
+{
+	srand( 0 );
+	state.assign( 2 * CLOTH_W * CLOTH_H, Vector3< T >() );
+	for( int i = 0; i < CLOTH_H; ++i )
+	{
+		for( int j = 0; j < CLOTH_W; ++j )
+		{
+			state[ 2 * indexOf( i, j ) ] = Vector3< T >( j * T( 0.2 ), -i * T( 0.2 ), randUniform( -0.01f, 0.01f ) );
+		}
+	}
+
+	return timeMs( [ &state ]()
+	{
+		for( int it = 0; it < CLOTH_ITERATIONS; ++it )
+		{
+			std::vector< Vector3< T > > f = clothEvalF( state );
+			for( size_t i = 0; i < state.size(); ++i )
+			{
+				state[ i ] += T( 1e-4 ) * f[ i ];
+			}
+		}
+	} );
+}
+
+}
+
+int main()
+{
+	std::vector< Vector3f > state;
+	std::vector< Vector3d > stateDouble;
+	double clothFloatMs = clothMs( state );
+	double clothDoubleMs = clothMs( stateDouble );
+
+	std::vector< Vector3f > bindVertices( SKIN_VERTICES );
+	std::vector< Vector3f > currentVertices( SKIN_VERTICES );
+	std::vector< std::vector< float > > attachments( SKIN_VERTICES, std::vector< float >( SKIN_JOINTS ) );
+	for( int i = 0; i < SKIN_VERTICES; ++i )
+	{
+		bindVertices[ i ] = Vector3f( randUniform( -1, 1 ), randUniform( -1, 1 ), randUniform( -1, 1 ) );
+		float sum = 0;
+		for( int j = 0; j < SKIN_JOINTS; ++j )
+		{
+			attachments[ i ][ j ] = randUniform( 0, 1 );
+			sum += attachments[ i ][ j ];
+		}
+		for( int j = 0; j < SKIN_JOINTS; ++j )
+		{
+			attachments[ i ][ j ] /= sum;
+		}
+	}
+	std::vector< Matrix4f > jointToWorld( SKIN_JOINTS );
+	std::vector< Matrix4f > bindWorldToJoint( SKIN_JOINTS );
+	for( int j = 0; j < SKIN_JOINTS; ++j )
+	{
+		Vector3f t( randUniform( -1, 1 ), randUniform( -1, 1 ), randUniform( -1, 1 ) );
+		jointToWorld[ j ] = Matrix4f::translation( t ) * Matrix4f::rotateY( randUniform( 0, 3 ) );
+		bindWorldToJoint[ j ] = Matrix4f::translation( -t );
+	}
+
+	double skinMs = timeMs( [ & ]()
+	{
+		for( int it = 0; it < SKIN_ITERATIONS; ++it )
+		{
+			skin( bindVertices, attachments, jointToWorld, bindWorldToJoint, currentVertices );
+			jointToWorld[ it % SKIN_JOINTS ] = jointToWorld[ it % SKIN_JOINTS ] * Matrix4f::rotateZ( 0.01f );
+		}
+	} );
+
+	// print a checksum so the work cannot be optimized away
+	float checksum = state[ 0 ].abs() + currentVertices[ 0 ].abs();
+
+#ifdef VECMATH_HEADER_ONLY
+	const char* mode = "header-only";
+#else
+	const char* mode = "library";
+#endif
+	printf( "vecmath mode: %s\n", mode );
+	printf( "cloth evalF (%dx%d, float):  %8.3f us / call\n", CLOTH_W, CLOTH_H, 1000.0 * clothFloatMs / CLOTH_ITERATIONS );
+	printf( "cloth evalF (%dx%d, double): %8.3f us / call\n", CLOTH_W, CLOTH_H, 1000.0 * clothDoubleMs / CLOTH_ITERATIONS );
+	printf( "float - double position difference after %d steps: %g\n", CLOTH_ITERATIONS, ( Vector3d( state[ 0 ] ) - stateDouble[ 0 ] ).abs() );
+	printf( "skinning (%d verts, %d joints): %8.3f ms / pass\n", SKIN_VERTICES, SKIN_JOINTS, skinMs / SKIN_ITERATIONS );
+	printf( "checksum: %f\n", checksum );
+	return 0;
+}
@@ -0,0 +1,388 @@
+// Microbenchmarks for individual vecmath operations, plus the bulk updates
+// of Vector3fArray next to the equivalent std::vector< Vector3f > loops and
+// the assn3 RK4 and trapezoidal state updates written with the Vector3f
+// operators and with the expression templates of VectorExpr.h, and
+// vecmath_trig::sincos next to sinf/cosf.
+//
+// Every operation is timed over arrays of several batch sizes, so that both
+// the cache-resident and the memory-bound cost show up. Results go to stdout
+// as CSV (default) or JSON, one record per operation and batch size, for
+// comparing builds (VECMATH_ISA, VECMATH_HEADER_ONLY, VECMATH_SIMD,
+// VECMATH_EIGEN, ...). The Eigen build also times plain Eigen::Matrix4f
+// arrays, for comparison with the vecmath types backed by Eigen.
+//
+// usage: vecmath_micro_bench [--format=csv|json] [--min-time=seconds]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "vecmath.h"
+#include "VectorExpr.h"
+#include "vecmath_eigen.h"
+#include "vecmath_simd.h"
+
+namespace
+{
+
+const int BATCH_SIZES[] = { 16, 256, 4096, 65536 };
+const int MAX_BATCH = 65536;
+
+struct Result
+{
+	std::string name;
+	int batch;
+	long long ops;
+	double seconds;
+};
+
+float randUniform( float lo, float hi )
+{
+	return lo + ( hi - lo ) * ( float )rand() / RAND_MAX;
+}
+
+Quat4f randomQuat()
+{
+	return Quat4f::randomRotation( randUniform( 0, 1 ), randUniform( 0, 1 ), randUniform( 0, 1 ) );
+}
+
+Matrix4f randomAffine()
+{
+	return Matrix4f::translation( randUniform( -1, 1 ), randUniform( -1, 1 ), randUniform( -1, 1 ) ) *
+		Matrix4f::rotation( randomQuat() ) *
+		Matrix4f::uniformScaling( randUniform( 0.5f, 2.0f ) );
+}
+
+// Runs kernel( n ) until minSeconds have passed, after one warm-up call.
+template< typename Kernel >
+Result run( const char* name, int n, double minSeconds, Kernel kernel )
+{
+	typedef std::chrono::steady_clock Clock;
+
+	kernel( n );
+
+	long long passes = 0;
+	double seconds = 0;
+	Clock::time_point start = Clock::now();
+	do
+	{
+		kernel( n );
+		++passes;
+		seconds = std::chrono::duration< double >( Clock::now() - start ).count();
+	} while( seconds < minSeconds );
+
+	Result r;
+	r.name = name;
+	r.batch = n;
+	r.ops = passes * n;
+	r.seconds = seconds;
+	return r;
+}
+
+const char* buildMode()
+{
+#ifdef VECMATH_HEADER_ONLY
+	return "header-only";
+#else
+	return "library";
+#endif
+}
+
+const char* backend()
+{
+#ifdef VECMATH_EIGEN
+	return "eigen";
+#else
+	return "vecmath";
+#endif
+}
+
+const char* simdLevel()
+{
+#if defined( VECMATH_AVX )
+	return "avx";
+#elif defined( VECMATH_SSE )
+	return "sse";
+#else
+	return "scalar";
+#endif
+}
+
+void printCsv( const std::vector< Result >& results )
+{
+	printf( "name,batch,ns_per_op,mops_per_s,ops,mode,simd,backend\n" );
+	for( size_t i = 0; i < results.size(); ++i )
+	{
+		const Result& r = results[ i ];
+		printf( "%s,%d,%.3f,%.3f,%lld,%s,%s,%s\n", r.name.c_str(), r.batch,
+			1e9 * r.seconds / r.ops, 1e-6 * r.ops / r.seconds, r.ops, buildMode(), simdLevel(), backend() );
+	}
+}
+
+void printJson( const std::vector< Result >& results )
+{
+	printf( "{\n  \"mode\": \"%s\",\n  \"simd\": \"%s\",\n  \"backend\": \"%s\",\n  \"results\": [\n",
+		buildMode(), simdLevel(), backend() );
+	for( size_t i = 0; i < results.size(); ++i )
+	{
+		const Result& r = results[ i ];
+		printf( "    { \"name\": \"%s\", \"batch\": %d, \"ns_per_op\": %.3f, \"mops_per_s\": %.3f, \"ops\": %lld }%s\n",
+			r.name.c_str(), r.batch, 1e9 * r.seconds / r.ops, 1e-6 * r.ops / r.seconds, r.ops,
+			i + 1 < results.size() ? "," : "" );
+	}
+	printf( "  ]\n}\n" );
+}
+
+}
+
+int main( int argc, char** argv )
+{
+	bool json = false;
+	double minSeconds = 0.05;
+	for( int i = 1; i < argc; ++i )
+	{
+		if( strcmp( argv[ i ], "--format=json" ) == 0 )
+		{
+			json = true;
+		}
+		else if( strcmp( argv[ i ], "--format=csv" ) == 0 )
+		{
+			json = false;
+		}
+		else if( strncmp( argv[ i ], "--min-time=", 11 ) == 0 )
+		{
+			minSeconds = atof( argv[ i ] + 11 );
+		}
+		else
+		{
+			fprintf( stderr, "usage: %s [--format=csv|json] [--min-time=seconds]\n", argv[ 0 ] );
+			return 1;
+		}
+	}
+
+	srand( 0 );
+	std::vector< Matrix4f > ma( MAX_BATCH ), mb( MAX_BATCH ), mOut( MAX_BATCH );
+	std::vector< Vector3f > va( MAX_BATCH ), vb( MAX_BATCH ), vOut( MAX_BATCH );
+	std::vector< Quat4f > qa( MAX_BATCH ), qb( MAX_BATCH ), qOut( MAX_BATCH );
+	for( int i = 0; i < MAX_BATCH; ++i )
+	{
+		ma[ i ] = randomAffine();
+		mb[ i ] = randomAffine();
+		va[ i ] = Vector3f( randUniform( -1, 1 ), randUniform( -1, 1 ), randUniform( -1, 1 ) );
+		vb[ i ] = Vector3f( randUniform( -1, 1 ), randUniform( -1, 1 ), randUniform( -1, 1 ) );
+		qa[ i ] = randomQuat();
+		qb[ i ] = randomQuat();
+	}
+	std::vector< Vector3f > k1( va ), k2( vb ), k3( va ), k4( vb ), out;
+	std::vector< float > angles( MAX_BATCH ), sines( MAX_BATCH ), cosines( MAX_BATCH );
+#ifdef VECMATH_EIGEN
+	typedef std::vector< Eigen::Matrix4f, Eigen::aligned_allocator< Eigen::Matrix4f > > EigenMatrices;
+	EigenMatrices ea( MAX_BATCH ), eb( MAX_BATCH ), eOut( MAX_BATCH );
+	for( int i = 0; i < MAX_BATCH; ++i )
+	{
+		ea[ i ] = vecmath_eigen::ConstMatrix4Map( ma[ i ] );
+		eb[ i ] = vecmath_eigen::ConstMatrix4Map( mb[ i ] );
+	}
+#endif
+	for( int i = 0; i < MAX_BATCH; ++i )
+	{
+		angles[ i ] = randUniform( -10, 10 );
+	}
+	Vector3fArray sa, sb;
+	Vector3fArray s1, s2, s3, s4;
+	float dotSum = 0;
+
+	std::vector< Result > results;
+	for( size_t b = 0; b < sizeof( BATCH_SIZES ) / sizeof( BATCH_SIZES[ 0 ] ); ++b )
+	{
+		int n = BATCH_SIZES[ b ];
+
+		results.push_back( run( "Matrix4f::operator*", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				mOut[ i ] = ma[ i ] * mb[ i ];
+			}
+		} ) );
+
+		results.push_back( run( "Matrix4f::inverse", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				mOut[ i ] = ma[ i ].inverse();
+			}
+		} ) );
+
+#ifdef VECMATH_EIGEN
+		results.push_back( run( "Eigen::Matrix4f::operator*", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				eOut[ i ].noalias() = ea[ i ] * eb[ i ];
+			}
+		} ) );
+
+		results.push_back( run( "Eigen::Matrix4f::inverse", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				eOut[ i ] = ea[ i ].inverse();
+			}
+		} ) );
+#endif
+
+		results.push_back( run( "Matrix4f::transposed", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				mOut[ i ] = ma[ i ].transposed();
+			}
+		} ) );
+
+		results.push_back( run( "Matrix4f::rotation(Quat4f)", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				mOut[ i ] = Matrix4f::rotation( qa[ i ] );
+			}
+		} ) );
+
+		results.push_back( run( "Vector3f::normalized", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				vOut[ i ] = va[ i ].normalized();
+			}
+		} ) );
+
+		results.push_back( run( "Vector3f::cross", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				vOut[ i ] = Vector3f::cross( va[ i ], vb[ i ] );
+			}
+		} ) );
+
+		results.push_back( run( "Vector3f::dot", n, minSeconds, [ & ]( int count )
+		{
+			float sum = 0;
+			for( int i = 0; i < count; ++i )
+			{
+				sum += Vector3f::dot( va[ i ], vb[ i ] );
+			}
+			dotSum += sum;
+		} ) );
+
+		// the same bulk updates on std::vector< Vector3f > and Vector3fArray
+		results.push_back( run( "axpy(std::vector<Vector3f>)", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				va[ i ] += 1e-6f * vb[ i ];
+			}
+		} ) );
+
+		sa.assign( std::vector< Vector3f >( va.begin(), va.begin() + n ) );
+		sb.assign( std::vector< Vector3f >( vb.begin(), vb.begin() + n ) );
+		results.push_back( run( "Vector3fArray::axpy", n, minSeconds, [ & ]( int count )
+		{
+			sa.axpy( 1e-6f, sb );
+		} ) );
+
+		// compare with Vector3f::normalized above
+		results.push_back( run( "Vector3fArray::normalize", n, minSeconds, [ & ]( int count )
+		{
+			sa.normalize();
+		} ) );
+
+		// RK4::takeStep and Trapezoidal::takeStep, h = 1e-3
+		results.push_back( run( "rk4 update(operators)", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				vOut[ i ] = va[ i ] + ( 1e-3f / 6.0f ) * ( k1[ i ] + 2 * k2[ i ] + 2 * k3[ i ] + k4[ i ] );
+			}
+		} ) );
+
+		std::vector< Vector3f > state( va.begin(), va.begin() + n ), f1( k1.begin(), k1.begin() + n ),
+			f2( k2.begin(), k2.begin() + n ), f3( k3.begin(), k3.begin() + n ), f4( k4.begin(), k4.begin() + n );
+		results.push_back( run( "rk4 update(expr std::vector)", n, minSeconds, [ & ]( int count )
+		{
+			using namespace vecmath_expr;
+			evaluate( out, expr( state ) + ( 1e-3f / 6.0f ) * ( expr( f1 ) + 2 * expr( f2 ) + 2 * expr( f3 ) + expr( f4 ) ) );
+		} ) );
+
+		s1.assign( f1 );
+		s2.assign( f2 );
+		s3.assign( f3 );
+		s4.assign( f4 );
+		sb.assign( state );
+		results.push_back( run( "rk4 update(expr Vector3fArray)", n, minSeconds, [ & ]( int count )
+		{
+			using namespace vecmath_expr;
+			evaluate( sa, expr( sb ) + ( 1e-3f / 6.0f ) * ( expr( s1 ) + 2 * expr( s2 ) + 2 * expr( s3 ) + expr( s4 ) ) );
+		} ) );
+
+		results.push_back( run( "trapezoidal update(operators)", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				vOut[ i ] = va[ i ] + ( 1e-3f / 2.0f ) * ( k1[ i ] + k2[ i ] );
+			}
+		} ) );
+
+		results.push_back( run( "trapezoidal update(expr std::vector)", n, minSeconds, [ & ]( int count )
+		{
+			using namespace vecmath_expr;
+			evaluate( out, expr( state ) + ( 1e-3f / 2.0f ) * ( expr( f1 ) + expr( f2 ) ) );
+		} ) );
+
+		results.push_back( run( "trapezoidal update(expr Vector3fArray)", n, minSeconds, [ & ]( int count )
+		{
+			using namespace vecmath_expr;
+			evaluate( sa, expr( sb ) + ( 1e-3f / 2.0f ) * ( expr( s1 ) + expr( s2 ) ) );
+		} ) );
+
+		results.push_back( run( "sinf+cosf", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				sines[ i ] = sinf( angles[ i ] );
+				cosines[ i ] = cosf( angles[ i ] );
+			}
+		} ) );
+
+		results.push_back( run( "vecmath_trig::sincos", n, minSeconds, [ & ]( int count )
+		{
+			vecmath_trig::sincos( &( angles[ 0 ] ), count, &( sines[ 0 ] ), &( cosines[ 0 ] ) );
+		} ) );
+
+		results.push_back( run( "Quat4f::slerp", n, minSeconds, [ & ]( int count )
+		{
+			for( int i = 0; i < count; ++i )
+			{
+				qOut[ i ] = Quat4f::slerp( qa[ i ], qb[ i ], 0.3f );
+			}
+		} ) );
+	}
+
+	if( json )
+	{
+		printJson( results );
+	}
+	else
+	{
+		printCsv( results );
+	}
+
+	// keep the results observable so the loops are not optimized away
+	fprintf( stderr, "checksum: %f\n", mOut[ 0 ]( 0, 0 ) + vOut[ 0 ][ 0 ] + qOut[ 0 ][ 0 ] + sa.x()[ 0 ] + out[ 0 ][ 0 ] + sines[ 0 ] + cosines[ 0 ] + dotSum );
+#ifdef VECMATH_EIGEN
+	fprintf( stderr, "eigen checksum: %f\n", eOut[ 0 ]( 0, 0 ) );
+#endif
+	return 0;
+}
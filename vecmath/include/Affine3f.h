@@ -0,0 +1,66 @@
+#ifndef AFFINE3F_H
+#define AFFINE3F_H
+
+#include <cstdio>
+
+#include "vecmath_fwd.h"
+
+class Matrix3f;
+
+// Affine transform [ A | t ], stored as the top 3x4 block of a 4x4 matrix
+// in column major order. The implicit last row is (0, 0, 0, 1).
+// Composition costs 36 multiplies instead of 64 for Matrix4f, and it takes
+// 48 bytes instead of 64.
+class Affine3f
+{
+public:
+	// identity
+	Affine3f();
+	Affine3f( const Matrix3f& linear, const Vector3f& translation );
+
+	// drops the last row of m, which is assumed to be (0, 0, 0, 1)
+	explicit Affine3f( const Matrix4f& m );
+
+	// i in [0, 3), j in [0, 4), column 3 is the translation
+	const float& operator () ( int i, int j ) const;
+	float& operator () ( int i, int j );
+
+	Matrix3f getLinear() const;
+	void setLinear( const Matrix3f& m );
+
+	Vector3f getTranslation() const;
+	void setTranslation( const Vector3f& v );
+
+	// A * p + t
+	Vector3f transformPoint( const Vector3f& p ) const;
+	// A * v
+	Vector3f transformVector( const Vector3f& v ) const;
+
+	Affine3f inverse( bool* pbIsSingular = NULL, float epsilon = 0.f ) const;
+	// assumes A is a rotation
+	Affine3f inverseRigid() const;
+
+	// 4x4 matrix with last row (0, 0, 0, 1), e.g. for uploading to GL
+	Matrix4f toMatrix4f() const;
+
+	void print();
+
+	static Affine3f identity();
+	static Affine3f translation( float x, float y, float z );
+	static Affine3f translation( const Vector3f& rTranslation );
+	static Affine3f rotation( const Matrix3f& m );
+
+private:
+
+	float m_elements[ 12 ];
+
+};
+
+// Composition, ( x * y ) applies y first
+Affine3f operator * ( const Affine3f& x, const Affine3f& y );
+
+#ifdef VECMATH_HEADER_ONLY
+#include "Affine3f.inl"
+#endif
+
+#endif // AFFINE3F_H
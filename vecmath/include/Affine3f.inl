@@ -0,0 +1,199 @@
+#ifndef AFFINE3F_INL
+#define AFFINE3F_INL
+
+#include "Affine3f.h"
+
+#include <cstdio>
+
+#include "Matrix3f.h"
+#include "Matrix4f.h"
+#include "Vector3f.h"
+#include "vecmath_inline.h"
+
+VECMATH_INLINE Affine3f::Affine3f()
+{
+	for( int i = 0; i < 12; ++i )
+	{
+		m_elements[ i ] = 0;
+	}
+	m_elements[ 0 ] = 1;
+	m_elements[ 4 ] = 1;
+	m_elements[ 8 ] = 1;
+}
+
+VECMATH_INLINE Affine3f::Affine3f( const Matrix3f& linear, const Vector3f& translation )
+{
+	setLinear( linear );
+	setTranslation( translation );
+}
+
+VECMATH_INLINE Affine3f::Affine3f( const Matrix4f& m )
+{
+	for( int j = 0; j < 4; ++j )
+	{
+		for( int i = 0; i < 3; ++i )
+		{
+			m_elements[ j * 3 + i ] = m( i, j );
+		}
+	}
+}
+
+VECMATH_INLINE const float& Affine3f::operator () ( int i, int j ) const
+{
+	return m_elements[ j * 3 + i ];
+}
+
+VECMATH_INLINE float& Affine3f::operator () ( int i, int j )
+{
+	return m_elements[ j * 3 + i ];
+}
+
+VECMATH_INLINE Matrix3f Affine3f::getLinear() const
+{
+	return Matrix3f
+	(
+		m_elements[ 0 ], m_elements[ 3 ], m_elements[ 6 ],
+		m_elements[ 1 ], m_elements[ 4 ], m_elements[ 7 ],
+		m_elements[ 2 ], m_elements[ 5 ], m_elements[ 8 ]
+	);
+}
+
+VECMATH_INLINE void Affine3f::setLinear( const Matrix3f& m )
+{
+	for( int j = 0; j < 3; ++j )
+	{
+		for( int i = 0; i < 3; ++i )
+		{
+			m_elements[ j * 3 + i ] = m( i, j );
+		}
+	}
+}
+
+VECMATH_INLINE Vector3f Affine3f::getTranslation() const
+{
+	return Vector3f( m_elements[ 9 ], m_elements[ 10 ], m_elements[ 11 ] );
+}
+
+VECMATH_INLINE void Affine3f::setTranslation( const Vector3f& v )
+{
+	m_elements[ 9 ] = v[ 0 ];
+	m_elements[ 10 ] = v[ 1 ];
+	m_elements[ 11 ] = v[ 2 ];
+}
+
+VECMATH_INLINE Vector3f Affine3f::transformPoint( const Vector3f& p ) const
+{
+	Vector3f output;
+	for( int i = 0; i < 3; ++i )
+	{
+		output[ i ] = m_elements[ i ] * p[ 0 ] + m_elements[ 3 + i ] * p[ 1 ] + m_elements[ 6 + i ] * p[ 2 ] + m_elements[ 9 + i ];
+	}
+	return output;
+}
+
+VECMATH_INLINE Vector3f Affine3f::transformVector( const Vector3f& v ) const
+{
+	Vector3f output;
+	for( int i = 0; i < 3; ++i )
+	{
+		output[ i ] = m_elements[ i ] * v[ 0 ] + m_elements[ 3 + i ] * v[ 1 ] + m_elements[ 6 + i ] * v[ 2 ];
+	}
+	return output;
+}
+
+VECMATH_INLINE Affine3f Affine3f::inverse( bool* pbIsSingular, float epsilon ) const
+{
+	bool isSingular;
+	Matrix3f inverseLinear = getLinear().inverse( &isSingular, epsilon );
+	if( pbIsSingular != NULL )
+	{
+		*pbIsSingular = isSingular;
+	}
+
+	Affine3f out( inverseLinear, Vector3f( 0, 0, 0 ) );
+	if( !isSingular )
+	{
+		out.setTranslation( -out.transformVector( getTranslation() ) );
+	}
+	return out;
+}
+
+VECMATH_INLINE Affine3f Affine3f::inverseRigid() const
+{
+	Affine3f out( getLinear().transposed(), Vector3f( 0, 0, 0 ) );
+	out.setTranslation( -out.transformVector( getTranslation() ) );
+	return out;
+}
+
+VECMATH_INLINE Matrix4f Affine3f::toMatrix4f() const
+{
+	return Matrix4f
+	(
+		m_elements[ 0 ], m_elements[ 3 ], m_elements[ 6 ], m_elements[ 9 ],
+		m_elements[ 1 ], m_elements[ 4 ], m_elements[ 7 ], m_elements[ 10 ],
+		m_elements[ 2 ], m_elements[ 5 ], m_elements[ 8 ], m_elements[ 11 ],
+		0, 0, 0, 1
+	);
+}
+
+VECMATH_INLINE void Affine3f::print()
+{
+	printf( "[ %.4f %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f %.4f ]\n",
+		m_elements[ 0 ], m_elements[ 3 ], m_elements[ 6 ], m_elements[ 9 ],
+		m_elements[ 1 ], m_elements[ 4 ], m_elements[ 7 ], m_elements[ 10 ],
+		m_elements[ 2 ], m_elements[ 5 ], m_elements[ 8 ], m_elements[ 11 ] );
+}
+
+// static
+VECMATH_INLINE Affine3f Affine3f::identity()
+{
+	return Affine3f();
+}
+
+// static
+VECMATH_INLINE Affine3f Affine3f::translation( float x, float y, float z )
+{
+	Affine3f out;
+	out.setTranslation( Vector3f( x, y, z ) );
+	return out;
+}
+
+// static
+VECMATH_INLINE Affine3f Affine3f::translation( const Vector3f& rTranslation )
+{
+	Affine3f out;
+	out.setTranslation( rTranslation );
+	return out;
+}
+
+// static
+VECMATH_INLINE Affine3f Affine3f::rotation( const Matrix3f& m )
+{
+	return Affine3f( m, Vector3f( 0, 0, 0 ) );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+
+VECMATH_INLINE Affine3f operator * ( const Affine3f& x, const Affine3f& y )
+{
+	Affine3f product;
+
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 4; ++j )
+		{
+			float sum = x( i, 0 ) * y( 0, j ) + x( i, 1 ) * y( 1, j ) + x( i, 2 ) * y( 2, j );
+			if( j == 3 )
+			{
+				sum += x( i, 3 );
+			}
+			product( i, j ) = sum;
+		}
+	}
+
+	return product;
+}
+
+#endif // AFFINE3F_INL
@@ -66,4 +66,8 @@ Vector2f operator * ( const Matrix2f& m, const Vector2f& v );
 // Matrix-Matrix multiplication
 Matrix2f operator * ( const Matrix2f& x, const Matrix2f& y );
 
+#ifdef VECMATH_HEADER_ONLY
+#include "Matrix2f.inl"
+#endif
+
 #endif // MATRIX2F_H
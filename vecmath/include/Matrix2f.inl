@@ -1,3 +1,6 @@
+#ifndef MATRIX2F_INL
+#define MATRIX2F_INL
+
 #include "Matrix2f.h"
 
 #include <cassert>
@@ -6,8 +9,9 @@
 #include <cstring>
 
 #include "Vector2f.h"
+#include "vecmath_inline.h"
 
-Matrix2f::Matrix2f( float fill )
+VECMATH_INLINE Matrix2f::Matrix2f( float fill )
 {
 	for( int i = 0; i < 4; ++i )
 	{
@@ -15,7 +19,7 @@ Matrix2f::Matrix2f( float fill )
 	}
 }
 
-Matrix2f::Matrix2f( float m00, float m01,
+VECMATH_INLINE Matrix2f::Matrix2f( float m00, float m01,
 				   float m10, float m11 )
 {
 	m_elements[ 0 ] = m00;
@@ -25,7 +29,7 @@ Matrix2f::Matrix2f( float m00, float m01,
 	m_elements[ 3 ] = m11;
 }
 
-Matrix2f::Matrix2f( const Vector2f& v0, const Vector2f& v1, bool setColumns )
+VECMATH_INLINE Matrix2f::Matrix2f( const Vector2f& v0, const Vector2f& v1, bool setColumns )
 {
 	if( setColumns )
 	{
@@ -39,12 +43,12 @@ Matrix2f::Matrix2f( const Vector2f& v0, const Vector2f& v1, bool setColumns )
 	}
 }
 
-Matrix2f::Matrix2f( const Matrix2f& rm )
+VECMATH_INLINE Matrix2f::Matrix2f( const Matrix2f& rm )
 {
 	memcpy( m_elements, rm.m_elements, sizeof(m_elements));
 }
 
-Matrix2f& Matrix2f::operator = ( const Matrix2f& rm )
+VECMATH_INLINE Matrix2f& Matrix2f::operator = ( const Matrix2f& rm )
 {
 	if( this != &rm )
 	{
@@ -53,17 +57,17 @@ Matrix2f& Matrix2f::operator = ( const Matrix2f& rm )
 	return *this;
 }
 
-const float& Matrix2f::operator () ( int i, int j ) const
+VECMATH_INLINE const float& Matrix2f::operator () ( int i, int j ) const
 {
 	return m_elements[ j * 2 + i ];
 }
 
-float& Matrix2f::operator () ( int i, int j )
+VECMATH_INLINE float& Matrix2f::operator () ( int i, int j )
 {
 	return m_elements[ j * 2 + i ];
 }
 
-Vector2f Matrix2f::getRow( int i ) const
+VECMATH_INLINE Vector2f Matrix2f::getRow( int i ) const
 {
 	return Vector2f
 	(
@@ -72,13 +76,13 @@ Vector2f Matrix2f::getRow( int i ) const
 	);
 }
 
-void Matrix2f::setRow( int i, const Vector2f& v )
+VECMATH_INLINE void Matrix2f::setRow( int i, const Vector2f& v )
 {
 	m_elements[ i ] = v.x();
 	m_elements[ i + 2 ] = v.y();
 }
 
-Vector2f Matrix2f::getCol( int j ) const
+VECMATH_INLINE Vector2f Matrix2f::getCol( int j ) const
 {
 	int colStart = 2 * j;
 
@@ -89,7 +93,7 @@ Vector2f Matrix2f::getCol( int j ) const
 	);
 }
 
-void Matrix2f::setCol( int j, const Vector2f& v )
+VECMATH_INLINE void Matrix2f::setCol( int j, const Vector2f& v )
 {
 	int colStart = 2 * j;
 
@@ -97,7 +101,7 @@ void Matrix2f::setCol( int j, const Vector2f& v )
 	m_elements[ colStart + 1 ] = v.y();
 }
 
-float Matrix2f::determinant()
+VECMATH_INLINE float Matrix2f::determinant()
 {
 	return Matrix2f::determinant2x2
 	(
@@ -106,7 +110,7 @@ float Matrix2f::determinant()
 	);
 }
 
-Matrix2f Matrix2f::inverse( bool* pbIsSingular, float epsilon )
+VECMATH_INLINE Matrix2f Matrix2f::inverse( bool* pbIsSingular, float epsilon )
 {
 	float determinant = m_elements[ 0 ] * m_elements[ 3 ] - m_elements[ 2 ] * m_elements[ 1 ];
 
@@ -136,7 +140,7 @@ Matrix2f Matrix2f::inverse( bool* pbIsSingular, float epsilon )
 	}
 }
 
-void Matrix2f::transpose()
+VECMATH_INLINE void Matrix2f::transpose()
 {
 	float m01 = ( *this )( 0, 1 );
 	float m10 = ( *this )( 1, 0 );
@@ -145,7 +149,7 @@ void Matrix2f::transpose()
 	( *this )( 1, 0 ) = m01;
 }
 
-Matrix2f Matrix2f::transposed() const
+VECMATH_INLINE Matrix2f Matrix2f::transposed() const
 {
 	return Matrix2f
 	(
@@ -155,12 +159,12 @@ Matrix2f Matrix2f::transposed() const
 
 }
 
-Matrix2f::operator float* ()
+VECMATH_INLINE Matrix2f::operator float* ()
 {
 	return m_elements;
 }
 
-void Matrix2f::print()
+VECMATH_INLINE void Matrix2f::print()
 {
 	printf( "[ %.4f %.4f ]\n[ %.4f %.4f ]\n",
 		m_elements[ 0 ], m_elements[ 2 ],
@@ -168,14 +172,14 @@ void Matrix2f::print()
 }
 
 // static
-float Matrix2f::determinant2x2( float m00, float m01,
+VECMATH_INLINE float Matrix2f::determinant2x2( float m00, float m01,
 							   float m10, float m11 )
 {
 	return( m00 * m11 - m01 * m10 );
 }
 
 // static
-Matrix2f Matrix2f::ones()
+VECMATH_INLINE Matrix2f Matrix2f::ones()
 {
 	Matrix2f m;
 	for( int i = 0; i < 4; ++i )
@@ -187,7 +191,7 @@ Matrix2f Matrix2f::ones()
 }
 
 // static
-Matrix2f Matrix2f::identity()
+VECMATH_INLINE Matrix2f Matrix2f::identity()
 {
 	Matrix2f m;
 
@@ -198,7 +202,7 @@ Matrix2f Matrix2f::identity()
 }
 
 // static
-Matrix2f Matrix2f::rotation( float degrees )
+VECMATH_INLINE Matrix2f Matrix2f::rotation( float degrees )
 {
 	float c = cos( degrees );
 	float s = sin( degrees );
@@ -214,7 +218,7 @@ Matrix2f Matrix2f::rotation( float degrees )
 // Operators
 //////////////////////////////////////////////////////////////////////////
 
-Matrix2f operator * ( float f, const Matrix2f& m )
+VECMATH_INLINE Matrix2f operator * ( float f, const Matrix2f& m )
 {
 	Matrix2f output;
 
@@ -229,12 +233,12 @@ Matrix2f operator * ( float f, const Matrix2f& m )
 	return output;
 }
 
-Matrix2f operator * ( const Matrix2f& m, float f )
+VECMATH_INLINE Matrix2f operator * ( const Matrix2f& m, float f )
 {
 	return f * m;
 }
 
-Vector2f operator * ( const Matrix2f& m, const Vector2f& v )
+VECMATH_INLINE Vector2f operator * ( const Matrix2f& m, const Vector2f& v )
 {
 	Vector2f output( 0, 0 );
 
@@ -249,7 +253,7 @@ Vector2f operator * ( const Matrix2f& m, const Vector2f& v )
 	return output;
 }
 
-Matrix2f operator * ( const Matrix2f& x, const Matrix2f& y )
+VECMATH_INLINE Matrix2f operator * ( const Matrix2f& x, const Matrix2f& y )
 {
 	Matrix2f product; // zeroes
 
@@ -266,3 +270,5 @@ Matrix2f operator * ( const Matrix2f& x, const Matrix2f& y )
 
 	return product;
 }
+
+#endif // MATRIX2F_INL
@@ -3,9 +3,9 @@
 
 #include <cstdio>
 
+#include "vecmath_fwd.h"
+
 class Matrix2f;
-class Quat4f;
-class Vector3f;
 
 // 3x3 Matrix, stored in column major order (OpenGL style)
 class Matrix3f
@@ -88,5 +88,8 @@ Matrix3f operator * ( const Matrix3f& x, const Matrix3f& y );
 Matrix3f operator * (const Matrix3f& m, float f);
 Matrix3f operator * (float f, const Matrix3f& m);
 
+#ifdef VECMATH_HEADER_ONLY
+#include "Matrix3f.inl"
+#endif
 
 #endif // MATRIX3F_H
@@ -1,3 +1,6 @@
+#ifndef MATRIX3F_INL
+#define MATRIX3F_INL
+
 #include "Matrix3f.h"
 
 #include <cassert>
@@ -8,8 +11,9 @@
 #include "Matrix2f.h"
 #include "Quat4f.h"
 #include "Vector3f.h"
+#include "vecmath_inline.h"
 
-Matrix3f::Matrix3f( float fill )
+VECMATH_INLINE Matrix3f::Matrix3f( float fill )
 {
 	for( int i = 0; i < 9; ++i )
 	{
@@ -17,7 +21,7 @@ Matrix3f::Matrix3f( float fill )
 	}
 }
 
-Matrix3f::Matrix3f( float m00, float m01, float m02,
+VECMATH_INLINE Matrix3f::Matrix3f( float m00, float m01, float m02,
 				   float m10, float m11, float m12,
 				   float m20, float m21, float m22 )
 {
@@ -34,7 +38,7 @@ Matrix3f::Matrix3f( float m00, float m01, float m02,
 	m_elements[ 8 ] = m22;
 }
 
-Matrix3f::Matrix3f( const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, bool setColumns )
+VECMATH_INLINE Matrix3f::Matrix3f( const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, bool setColumns )
 {
 	if( setColumns )
 	{
@@ -50,12 +54,12 @@ Matrix3f::Matrix3f( const Vector3f& v0, const Vector3f& v1, const Vector3f& v2,
 	}
 }
 
-Matrix3f::Matrix3f( const Matrix3f& rm )
+VECMATH_INLINE Matrix3f::Matrix3f( const Matrix3f& rm )
 {
 	memcpy( m_elements, rm.m_elements, sizeof(m_elements)  );
 }
 
-Matrix3f& Matrix3f::operator = ( const Matrix3f& rm )
+VECMATH_INLINE Matrix3f& Matrix3f::operator = ( const Matrix3f& rm )
 {
 	if( this != &rm )
 	{
@@ -64,17 +68,17 @@ Matrix3f& Matrix3f::operator = ( const Matrix3f& rm )
 	return *this;
 }
 
-const float& Matrix3f::operator () ( int i, int j ) const
+VECMATH_INLINE const float& Matrix3f::operator () ( int i, int j ) const
 {
 	return m_elements[ j * 3 + i ];
 }
 
-float& Matrix3f::operator () ( int i, int j )
+VECMATH_INLINE float& Matrix3f::operator () ( int i, int j )
 {
 	return m_elements[ j * 3 + i ];
 }
 
-Vector3f Matrix3f::getRow( int i ) const
+VECMATH_INLINE Vector3f Matrix3f::getRow( int i ) const
 {
 	return Vector3f
 	(
@@ -84,14 +88,14 @@ Vector3f Matrix3f::getRow( int i ) const
 	);
 }
 
-void Matrix3f::setRow( int i, const Vector3f& v )
+VECMATH_INLINE void Matrix3f::setRow( int i, const Vector3f& v )
 {
 	m_elements[ i ] = v.x();
 	m_elements[ i + 3 ] = v.y();
 	m_elements[ i + 6 ] = v.z();
 }
 
-Vector3f Matrix3f::getCol( int j ) const
+VECMATH_INLINE Vector3f Matrix3f::getCol( int j ) const
 {
 	int colStart = 3 * j;
 
@@ -103,7 +107,7 @@ Vector3f Matrix3f::getCol( int j ) const
 	);
 }
 
-void Matrix3f::setCol( int j, const Vector3f& v )
+VECMATH_INLINE void Matrix3f::setCol( int j, const Vector3f& v )
 {
 	int colStart = 3 * j;
 
@@ -112,7 +116,7 @@ void Matrix3f::setCol( int j, const Vector3f& v )
 	m_elements[ colStart + 2 ] = v.z();
 }
 
-Matrix2f Matrix3f::getSubmatrix2x2( int i0, int j0 ) const
+VECMATH_INLINE Matrix2f Matrix3f::getSubmatrix2x2( int i0, int j0 ) const
 {
 	Matrix2f out;
 
@@ -127,7 +131,7 @@ Matrix2f Matrix3f::getSubmatrix2x2( int i0, int j0 ) const
 	return out;
 }
 
-void Matrix3f::setSubmatrix2x2( int i0, int j0, const Matrix2f& m )
+VECMATH_INLINE void Matrix3f::setSubmatrix2x2( int i0, int j0, const Matrix2f& m )
 {
 	for( int i = 0; i < 2; ++i )
 	{
@@ -138,7 +142,7 @@ void Matrix3f::setSubmatrix2x2( int i0, int j0, const Matrix2f& m )
 	}
 }
 
-float Matrix3f::determinant() const
+VECMATH_INLINE float Matrix3f::determinant() const
 {
 	return Matrix3f::determinant3x3
 	(
@@ -148,7 +152,7 @@ float Matrix3f::determinant() const
 	);
 }
 
-Matrix3f Matrix3f::inverse( bool* pbIsSingular, float epsilon ) const
+VECMATH_INLINE Matrix3f Matrix3f::inverse( bool* pbIsSingular, float epsilon ) const
 {
 	float m00 = m_elements[ 0 ];
 	float m10 = m_elements[ 1 ];
@@ -203,7 +207,7 @@ Matrix3f Matrix3f::inverse( bool* pbIsSingular, float epsilon ) const
 	}
 }
 
-void Matrix3f::transpose()
+VECMATH_INLINE void Matrix3f::transpose()
 {
 	float temp;
 
@@ -218,7 +222,7 @@ void Matrix3f::transpose()
 	}
 }
 
-Matrix3f Matrix3f::transposed() const
+VECMATH_INLINE Matrix3f Matrix3f::transposed() const
 {
 	Matrix3f out;
 	for( int i = 0; i < 3; ++i )
@@ -232,12 +236,12 @@ Matrix3f Matrix3f::transposed() const
 	return out;
 }
 
-Matrix3f::operator float* ()
+VECMATH_INLINE Matrix3f::operator float* ()
 {
 	return m_elements;
 }
 
-void Matrix3f::print()
+VECMATH_INLINE void Matrix3f::print()
 {
 	printf( "[ %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f ]\n",
 		m_elements[ 0 ], m_elements[ 3 ], m_elements[ 6 ],
@@ -246,7 +250,7 @@ void Matrix3f::print()
 }
 
 // static
-float Matrix3f::determinant3x3( float m00, float m01, float m02,
+VECMATH_INLINE float Matrix3f::determinant3x3( float m00, float m01, float m02,
 							   float m10, float m11, float m12,
 							   float m20, float m21, float m22 )
 {
@@ -259,7 +263,7 @@ float Matrix3f::determinant3x3( float m00, float m01, float m02,
 }
 
 // static
-Matrix3f Matrix3f::ones()
+VECMATH_INLINE Matrix3f Matrix3f::ones()
 {
 	Matrix3f m;
 	for( int i = 0; i < 9; ++i )
@@ -271,7 +275,7 @@ Matrix3f Matrix3f::ones()
 }
 
 // static
-Matrix3f Matrix3f::identity()
+VECMATH_INLINE Matrix3f Matrix3f::identity()
 {
 	Matrix3f m;
 
@@ -284,7 +288,7 @@ Matrix3f Matrix3f::identity()
 
 
 // static
-Matrix3f Matrix3f::rotateX( float radians )
+VECMATH_INLINE Matrix3f Matrix3f::rotateX( float radians )
 {
 	float c = cos( radians );
 	float s = sin( radians );
@@ -298,7 +302,7 @@ Matrix3f Matrix3f::rotateX( float radians )
 }
 
 // static
-Matrix3f Matrix3f::rotateY( float radians )
+VECMATH_INLINE Matrix3f Matrix3f::rotateY( float radians )
 {
 	float c = cos( radians );
 	float s = sin( radians );
@@ -312,7 +316,7 @@ Matrix3f Matrix3f::rotateY( float radians )
 }
 
 // static
-Matrix3f Matrix3f::rotateZ( float radians )
+VECMATH_INLINE Matrix3f Matrix3f::rotateZ( float radians )
 {
 	float c = cos( radians );
 	float s = sin( radians );
@@ -326,7 +330,7 @@ Matrix3f Matrix3f::rotateZ( float radians )
 }
 
 // static
-Matrix3f Matrix3f::scaling( float sx, float sy, float sz )
+VECMATH_INLINE Matrix3f Matrix3f::scaling( float sx, float sy, float sz )
 {
 	return Matrix3f
 	(
@@ -337,7 +341,7 @@ Matrix3f Matrix3f::scaling( float sx, float sy, float sz )
 }
 
 // static
-Matrix3f Matrix3f::uniformScaling( float s )
+VECMATH_INLINE Matrix3f Matrix3f::uniformScaling( float s )
 {
 	return Matrix3f
 	(
@@ -348,7 +352,7 @@ Matrix3f Matrix3f::uniformScaling( float s )
 }
 
 // static
-Matrix3f Matrix3f::rotation( const Vector3f& rDirection, float radians )
+VECMATH_INLINE Matrix3f Matrix3f::rotation( const Vector3f& rDirection, float radians )
 {
 	Vector3f normalizedDirection = rDirection.normalized();
 	
@@ -368,7 +372,7 @@ Matrix3f Matrix3f::rotation( const Vector3f& rDirection, float radians )
 }
 
 // static
-Matrix3f Matrix3f::rotation( const Quat4f& rq )
+VECMATH_INLINE Matrix3f Matrix3f::rotation( const Quat4f& rq )
 {
 	Quat4f q = rq.normalized();
 
@@ -397,7 +401,7 @@ Matrix3f Matrix3f::rotation( const Quat4f& rq )
 // Operators
 //////////////////////////////////////////////////////////////////////////
 
-Vector3f operator * ( const Matrix3f& m, const Vector3f& v )
+VECMATH_INLINE Vector3f operator * ( const Matrix3f& m, const Vector3f& v )
 {
 	Vector3f output( 0, 0, 0 );
 
@@ -412,7 +416,7 @@ Vector3f operator * ( const Matrix3f& m, const Vector3f& v )
 	return output;
 }
 
-Matrix3f operator * ( const Matrix3f& x, const Matrix3f& y )
+VECMATH_INLINE Matrix3f operator * ( const Matrix3f& x, const Matrix3f& y )
 {
 	Matrix3f product; // zeroes
 
@@ -430,7 +434,7 @@ Matrix3f operator * ( const Matrix3f& x, const Matrix3f& y )
 	return product;
 }
 // Scalar multiplication 
-Matrix3f operator * (const Matrix3f& m, float f) {
+VECMATH_INLINE Matrix3f operator * (const Matrix3f& m, float f) {
     Matrix3f product(m); // zeroes
 
     for (int i = 0; i < 3; ++i)
@@ -442,7 +446,7 @@ Matrix3f operator * (const Matrix3f& m, float f) {
     }
     return product;
 }
-Matrix3f operator * (float f, const Matrix3f& m) {
+VECMATH_INLINE Matrix3f operator * (float f, const Matrix3f& m) {
     Matrix3f product(m); // zeroes
     for (int i = 0; i < 3; ++i)
     {
@@ -453,3 +457,5 @@ Matrix3f operator * (float f, const Matrix3f& m) {
     }
     return product;
 }
+
+#endif // MATRIX3F_INL
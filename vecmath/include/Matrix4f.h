@@ -0,0 +1,180 @@
+#ifndef MATRIX4F_H
+#define MATRIX4F_H
+
+#include <cstdio>
+
+#include "vecmath_fwd.h"
+#include "vecmath_inline.h"
+#include "vecmath_simd.h"
+
+class Matrix2f;
+class Matrix3f;
+class Vector4f;
+
+// 4x4 Matrix, stored in column major order (OpenGL style).
+// Matrix4f for float and Matrix4d for double; the members taking or
+// returning the float only Vector4f, Matrix2f and Matrix3f convert.
+template< typename T >
+class Matrix4
+{
+public:
+
+    typedef T value_type;
+
+    // Fill a 4x4 matrix with "fill".  Default to 0.
+    explicit Matrix4(T fill = 0);
+    Matrix4(T m00, T m01, T m02, T m03,
+        T m10, T m11, T m12, T m13,
+        T m20, T m21, T m22, T m23,
+        T m30, T m31, T m32, T m33);
+
+    // setColumns = true ==> sets the columns of the matrix to be [v0 v1 v2 v3]
+    // otherwise, sets the rows
+    Matrix4(const Vector4f& v0, const Vector4f& v1, const Vector4f& v2, const Vector4f& v3, bool setColumns = true);
+
+    Matrix4(const Matrix4& rm); // copy constructor
+
+    // converts from another precision, e.g. Matrix4f(Matrix4d(...))
+    template< typename U >
+    explicit Matrix4(const Matrix4< U >& rm);
+
+    Matrix4& operator = (const Matrix4& rm); // assignment operator
+    Matrix4& operator/=(T d);
+    // no destructor necessary
+
+    const T& operator () (int i, int j) const;
+    T& operator () (int i, int j);
+
+    Vector4f getRow(int i) const;
+    void setRow(int i, const Vector4f& v);
+
+    // get column j (mod 4)
+    Vector4f getCol(int j) const;
+    void setCol(int j, const Vector4f& v);
+
+    // gets the 2x2 submatrix of this matrix to m
+    // starting with upper left corner at (i0, j0)
+    Matrix2f getSubmatrix2x2(int i0, int j0) const;
+
+    // gets the 3x3 submatrix of this matrix to m
+    // starting with upper left corner at (i0, j0)
+    Matrix3f getSubmatrix3x3(int i0, int j0) const;
+
+    // sets a 2x2 submatrix of this matrix to m
+    // starting with upper left corner at (i0, j0)
+    void setSubmatrix2x2(int i0, int j0, const Matrix2f& m);
+
+    // sets a 3x3 submatrix of this matrix to m
+    // starting with upper left corner at (i0, j0)
+    void setSubmatrix3x3(int i0, int j0, const Matrix3f& m);
+
+    T determinant() const;
+    Matrix4 inverse(bool* pbIsSingular = NULL, T epsilon = 0) const;
+
+    // Cheaper inverses for matrices with a known structure.
+    // inverseAffine() assumes the last row is (0, 0, 0, 1) and only inverts
+    // the upper-left 3x3 block. inverseRigid() additionally assumes that the
+    // block is a pure rotation and uses its transpose.
+    Matrix4 inverseAffine(bool* pbIsSingular = NULL, T epsilon = 0) const;
+    Matrix4 inverseRigid() const;
+
+    // Matrix for transforming normals by an affine matrix: the inverse
+    // transpose of the upper-left 3x3 block, with no translation.
+    // Gives the same xyz results as inverse().transposed() for normals.
+    Matrix4 normalMatrix() const;
+
+    void transpose();
+    Matrix4 transposed() const;
+
+    // Batched transforms of n vectors, out[i] = (M * (in[i], w)).xyz()
+    // with w = 1 for points and w = 0 for directions (no homogeneous divide).
+    // out may be the same array as in.
+    void transformPoints(const Vector3< T >* in, Vector3< T >* out, int n) const;
+    void transformDirections(const Vector3< T >* in, Vector3< T >* out, int n) const;
+
+    // out[i] += weights[i] * (M * (in[i], 1)).xyz(), e.g. one joint's
+    // contribution in linear blend skinning
+    void accumulateTransformedPoints(const Vector3< T >* in, const T* weights, Vector3< T >* out, int n) const;
+
+    // ---- Utility ----
+    operator T* (); // automatic type conversion for GL
+    operator const T* () const; // automatic type conversion for GL
+
+    void print();
+
+    static Matrix4 ones();
+    static Matrix4 identity();
+    static Matrix4 translation(T x, T y, T z);
+    static Matrix4 translation(const Vector3< T >& rTranslation);
+    static Matrix4 rotateX(T radians);
+    static Matrix4 rotateY(T radians);
+    static Matrix4 rotateZ(T radians);
+    static Matrix4 rotation(const Vector3< T >& rDirection, T radians);
+    static Matrix4 scaling(T sx, T sy, T sz);
+    static Matrix4 uniformScaling(T s);
+    static Matrix4 lookAt(const Vector3< T >& eye, const Vector3< T >& center, const Vector3< T >& up);
+    static Matrix4 orthographicProjection(T width, T height, T zNear, T zFar, bool directX = false);
+    static Matrix4 orthographicProjection(T left, T right, T bottom, T top, T zNear, T zFar, bool directX = false);
+    static Matrix4 perspectiveProjection(T fLeft, T fRight, T fBottom, T fTop, T fZNear, T fZFar, bool directX = false);
+    static Matrix4 perspectiveProjection(T fovYRadians, T aspect, T zNear, T zFar, bool directX = false);
+    static Matrix4 infinitePerspectiveProjection(T fLeft, T fRight, T fBottom, T fTop, T fZNear, bool directX = false);
+
+    // Returns the rotation matrix represented by a quaternion
+    // uses a normalized version of q
+    static Matrix4 rotation(const Quat4< T >& q);
+
+    // returns an orthogonal matrix that's a uniformly distributed rotation
+    // given u[i] is a uniformly distributed random number in [0,1]
+    static Matrix4 randomRotation(T u0, T u1, T u2);
+
+private:
+
+    T m_elements[16];
+
+};
+
+// Matrix-Vector multiplication
+// 4x4 * 4x1 ==> 4x1
+template< typename T >
+Vector4f operator * (const Matrix4< T >& m, const Vector4f& v);
+
+// Matrix-Matrix multiplication
+template< typename T >
+Matrix4< T > operator * (const Matrix4< T >& x, const Matrix4< T >& y);
+
+// Scalar multiplication 
+template< typename T >
+Matrix4< T > operator * (const Matrix4< T >& m, typename Matrix4< T >::value_type f);
+template< typename T >
+Matrix4< T > operator * (typename Matrix4< T >::value_type f, const Matrix4< T >& m);
+
+#if defined( VECMATH_SSE ) || defined( VECMATH_EIGEN )
+// SSE/AVX or Eigen versions for float, defined at the end of Matrix4f.inl
+template<> VECMATH_INLINE Matrix4< float > Matrix4< float >::inverse(bool* pbIsSingular, float epsilon) const;
+template<> VECMATH_INLINE void Matrix4< float >::transpose();
+template<> VECMATH_INLINE void Matrix4< float >::transformPoints(const Vector3f* in, Vector3f* out, int n) const;
+template<> VECMATH_INLINE void Matrix4< float >::transformDirections(const Vector3f* in, Vector3f* out, int n) const;
+template<> VECMATH_INLINE void Matrix4< float >::accumulateTransformedPoints(const Vector3f* in, const float* weights, Vector3f* out, int n) const;
+template<> VECMATH_INLINE Vector4f operator * (const Matrix4< float >& m, const Vector4f& v);
+template<> VECMATH_INLINE Matrix4< float > operator * (const Matrix4< float >& x, const Matrix4< float >& y);
+#endif
+
+// defined here in both build modes, see Vector3f.h
+template< typename T >
+template< typename U >
+Matrix4< T >::Matrix4(const Matrix4< U >& rm)
+{
+    for (int j = 0; j < 4; ++j)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            (*this)(i, j) = static_cast< T >(rm(i, j));
+        }
+    }
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "Matrix4f.inl"
+#endif
+
+#endif // MATRIX4F_H
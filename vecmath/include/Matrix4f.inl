@@ -0,0 +1,1319 @@
+#ifndef MATRIX4F_INL
+#define MATRIX4F_INL
+
+#include "Matrix4f.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "Matrix2f.h"
+#include "Matrix3f.h"
+#include "Quat4f.h"
+#include "Vector3f.h"
+#include "Vector4f.h"
+#include "vecmath_eigen.h"
+#include "vecmath_simd.h"
+#include "vecmath_inline.h"
+
+namespace vecmath_detail
+{
+	// Matrix3f::determinant3x3() and Matrix3f::inverse() for any scalar type,
+	// so that Matrix4d does not go through the float only Matrix3f
+
+	template< typename T >
+	T determinant3x3( T m00, T m01, T m02,
+		T m10, T m11, T m12,
+		T m20, T m21, T m22 )
+	{
+		return
+			(
+				  m00 * ( m11 * m22 - m12 * m21 )
+				- m01 * ( m10 * m22 - m12 * m20 )
+				+ m02 * ( m10 * m21 - m11 * m20 )
+			);
+	}
+
+	// inverse of the upper left 3x3 block of the column major 4x4 matrix m,
+	// written column major to out[ 9 ]; false if it is singular
+	template< typename T >
+	bool inverse3x3( const T* m, T* out, T epsilon )
+	{
+		T m00 = m[ 0 ];
+		T m10 = m[ 1 ];
+		T m20 = m[ 2 ];
+
+		T m01 = m[ 4 ];
+		T m11 = m[ 5 ];
+		T m21 = m[ 6 ];
+
+		T m02 = m[ 8 ];
+		T m12 = m[ 9 ];
+		T m22 = m[ 10 ];
+
+		T cofactor00 =  ( m11 * m22 - m12 * m21 );
+		T cofactor01 = -( m10 * m22 - m12 * m20 );
+		T cofactor02 =  ( m10 * m21 - m11 * m20 );
+
+		T cofactor10 = -( m01 * m22 - m02 * m21 );
+		T cofactor11 =  ( m00 * m22 - m02 * m20 );
+		T cofactor12 = -( m00 * m21 - m01 * m20 );
+
+		T cofactor20 =  ( m01 * m12 - m02 * m11 );
+		T cofactor21 = -( m00 * m12 - m02 * m10 );
+		T cofactor22 =  ( m00 * m11 - m01 * m10 );
+
+		T determinant = m00 * cofactor00 + m01 * cofactor01 + m02 * cofactor02;
+		if( fabs( determinant ) < epsilon )
+		{
+			return false;
+		}
+
+		T reciprocalDeterminant = 1 / determinant;
+
+		// the inverse is the transposed cofactor matrix over the determinant
+		out[ 0 ] = cofactor00 * reciprocalDeterminant;
+		out[ 1 ] = cofactor01 * reciprocalDeterminant;
+		out[ 2 ] = cofactor02 * reciprocalDeterminant;
+		out[ 3 ] = cofactor10 * reciprocalDeterminant;
+		out[ 4 ] = cofactor11 * reciprocalDeterminant;
+		out[ 5 ] = cofactor12 * reciprocalDeterminant;
+		out[ 6 ] = cofactor20 * reciprocalDeterminant;
+		out[ 7 ] = cofactor21 * reciprocalDeterminant;
+		out[ 8 ] = cofactor22 * reciprocalDeterminant;
+		return true;
+	}
+}
+
+template< typename T >
+Matrix4< T >::Matrix4( T fill )
+{
+	for( int i = 0; i < 16; ++i )
+	{
+		m_elements[ i ] = fill;
+	}
+}
+
+template< typename T >
+Matrix4< T >::Matrix4( T m00, T m01, T m02, T m03,
+				   T m10, T m11, T m12, T m13,
+				   T m20, T m21, T m22, T m23,
+				   T m30, T m31, T m32, T m33 )
+{
+	m_elements[ 0 ] = m00;
+	m_elements[ 1 ] = m10;
+	m_elements[ 2 ] = m20;
+	m_elements[ 3 ] = m30;
+	
+	m_elements[ 4 ] = m01;
+	m_elements[ 5 ] = m11;
+	m_elements[ 6 ] = m21;
+	m_elements[ 7 ] = m31;
+
+	m_elements[ 8 ] = m02;
+	m_elements[ 9 ] = m12;
+	m_elements[ 10 ] = m22;
+	m_elements[ 11 ] = m32;
+
+	m_elements[ 12 ] = m03;
+	m_elements[ 13 ] = m13;
+	m_elements[ 14 ] = m23;
+	m_elements[ 15 ] = m33;
+}
+
+template< typename T >
+Matrix4< T >& Matrix4< T >::operator/=(T d)
+{
+	for(int ii=0;ii<16;ii++){
+		m_elements[ii]/=d;
+	}
+	return *this;
+}
+
+template< typename T >
+Matrix4< T >::Matrix4( const Vector4f& v0, const Vector4f& v1, const Vector4f& v2, const Vector4f& v3, bool setColumns )
+{
+	if( setColumns )
+	{
+		setCol( 0, v0 );
+		setCol( 1, v1 );
+		setCol( 2, v2 );
+		setCol( 3, v3 );
+	}
+	else
+	{
+		setRow( 0, v0 );
+		setRow( 1, v1 );
+		setRow( 2, v2 );
+		setRow( 3, v3 );
+	}
+}
+
+template< typename T >
+Matrix4< T >::Matrix4( const Matrix4< T >& rm )
+{
+	memcpy( m_elements, rm.m_elements, sizeof(m_elements) );
+}
+
+template< typename T >
+Matrix4< T >& Matrix4< T >::operator = ( const Matrix4< T >& rm )
+{
+	if( this != &rm )
+	{
+		memcpy( m_elements, rm.m_elements, sizeof(m_elements)  );
+	}
+	return *this;
+}
+
+template< typename T >
+const T& Matrix4< T >::operator () ( int i, int j ) const
+{
+	return m_elements[ j * 4 + i ];
+}
+
+template< typename T >
+T& Matrix4< T >::operator () ( int i, int j )
+{
+	return m_elements[ j * 4 + i ];
+}
+
+template< typename T >
+Vector4f Matrix4< T >::getRow( int i ) const
+{
+	return Vector4f
+	(
+		m_elements[ i ],
+		m_elements[ i + 4 ],
+		m_elements[ i + 8 ],
+		m_elements[ i + 12 ]
+	);
+}
+
+template< typename T >
+void Matrix4< T >::setRow( int i, const Vector4f& v )
+{
+	m_elements[ i ] = v.x();
+	m_elements[ i + 4 ] = v.y();
+	m_elements[ i + 8 ] = v.z();
+	m_elements[ i + 12 ] = v.w();
+}
+
+template< typename T >
+Vector4f Matrix4< T >::getCol( int j ) const
+{
+	int colStart = 4 * j;
+
+	return Vector4f
+	(
+		m_elements[ colStart ],
+		m_elements[ colStart + 1 ],
+		m_elements[ colStart + 2 ],
+		m_elements[ colStart + 3 ]
+	);
+}
+
+template< typename T >
+void Matrix4< T >::setCol( int j, const Vector4f& v )
+{
+	int colStart = 4 * j;
+
+	m_elements[ colStart ] = v.x();
+	m_elements[ colStart + 1 ] = v.y();
+	m_elements[ colStart + 2 ] = v.z();
+	m_elements[ colStart + 3 ] = v.w();
+}
+
+template< typename T >
+Matrix2f Matrix4< T >::getSubmatrix2x2( int i0, int j0 ) const
+{
+	Matrix2f out;
+
+	for( int i = 0; i < 2; ++i )
+	{
+		for( int j = 0; j < 2; ++j )
+		{
+			out( i, j ) = ( *this )( i + i0, j + j0 );
+		}
+	}
+
+	return out;
+}
+
+template< typename T >
+Matrix3f Matrix4< T >::getSubmatrix3x3( int i0, int j0 ) const
+{
+	Matrix3f out;
+
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 3; ++j )
+		{
+			out( i, j ) = ( *this )( i + i0, j + j0 );
+		}
+	}
+
+	return out;
+}
+
+template< typename T >
+void Matrix4< T >::setSubmatrix2x2( int i0, int j0, const Matrix2f& m )
+{
+	for( int i = 0; i < 2; ++i )
+	{
+		for( int j = 0; j < 2; ++j )
+		{
+			( *this )( i + i0, j + j0 ) = m( i, j );
+		}
+	}
+}
+
+template< typename T >
+void Matrix4< T >::setSubmatrix3x3( int i0, int j0, const Matrix3f& m )
+{
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 3; ++j )
+		{
+			( *this )( i + i0, j + j0 ) = m( i, j );
+		}
+	}
+}
+
+template< typename T >
+T Matrix4< T >::determinant() const
+{
+	T m00 = m_elements[ 0 ];
+	T m10 = m_elements[ 1 ];
+	T m20 = m_elements[ 2 ];
+	T m30 = m_elements[ 3 ];
+
+	T m01 = m_elements[ 4 ];
+	T m11 = m_elements[ 5 ];
+	T m21 = m_elements[ 6 ];
+	T m31 = m_elements[ 7 ];
+
+	T m02 = m_elements[ 8 ];
+	T m12 = m_elements[ 9 ];
+	T m22 = m_elements[ 10 ];
+	T m32 = m_elements[ 11 ];
+
+	T m03 = m_elements[ 12 ];
+	T m13 = m_elements[ 13 ];
+	T m23 = m_elements[ 14 ];
+	T m33 = m_elements[ 15 ];
+
+	T cofactor00 =  vecmath_detail::determinant3x3( m11, m12, m13, m21, m22, m23, m31, m32, m33 );
+	T cofactor01 = -vecmath_detail::determinant3x3( m12, m13, m10, m22, m23, m20, m32, m33, m30 );
+	T cofactor02 =  vecmath_detail::determinant3x3( m13, m10, m11, m23, m20, m21, m33, m30, m31 );
+	T cofactor03 = -vecmath_detail::determinant3x3( m10, m11, m12, m20, m21, m22, m30, m31, m32 );
+
+	return( m00 * cofactor00 + m01 * cofactor01 + m02 * cofactor02 + m03 * cofactor03 );
+}
+
+template< typename T >
+Matrix4< T > Matrix4< T >::inverse( bool* pbIsSingular, T epsilon ) const
+{
+	T m00 = m_elements[ 0 ];
+	T m10 = m_elements[ 1 ];
+	T m20 = m_elements[ 2 ];
+	T m30 = m_elements[ 3 ];
+
+	T m01 = m_elements[ 4 ];
+	T m11 = m_elements[ 5 ];
+	T m21 = m_elements[ 6 ];
+	T m31 = m_elements[ 7 ];
+
+	T m02 = m_elements[ 8 ];
+	T m12 = m_elements[ 9 ];
+	T m22 = m_elements[ 10 ];
+	T m32 = m_elements[ 11 ];
+
+	T m03 = m_elements[ 12 ];
+	T m13 = m_elements[ 13 ];
+	T m23 = m_elements[ 14 ];
+	T m33 = m_elements[ 15 ];
+
+    T cofactor00 =  vecmath_detail::determinant3x3( m11, m12, m13, m21, m22, m23, m31, m32, m33 );
+    T cofactor01 = -vecmath_detail::determinant3x3( m12, m13, m10, m22, m23, m20, m32, m33, m30 );
+    T cofactor02 =  vecmath_detail::determinant3x3( m13, m10, m11, m23, m20, m21, m33, m30, m31 );
+    T cofactor03 = -vecmath_detail::determinant3x3( m10, m11, m12, m20, m21, m22, m30, m31, m32 );
+    
+    T cofactor10 = -vecmath_detail::determinant3x3( m21, m22, m23, m31, m32, m33, m01, m02, m03 );
+    T cofactor11 =  vecmath_detail::determinant3x3( m22, m23, m20, m32, m33, m30, m02, m03, m00 );
+    T cofactor12 = -vecmath_detail::determinant3x3( m23, m20, m21, m33, m30, m31, m03, m00, m01 );
+    T cofactor13 =  vecmath_detail::determinant3x3( m20, m21, m22, m30, m31, m32, m00, m01, m02 );
+    
+    T cofactor20 =  vecmath_detail::determinant3x3( m31, m32, m33, m01, m02, m03, m11, m12, m13 );
+    T cofactor21 = -vecmath_detail::determinant3x3( m32, m33, m30, m02, m03, m00, m12, m13, m10 );
+    T cofactor22 =  vecmath_detail::determinant3x3( m33, m30, m31, m03, m00, m01, m13, m10, m11 );
+    T cofactor23 = -vecmath_detail::determinant3x3( m30, m31, m32, m00, m01, m02, m10, m11, m12 );
+    
+    T cofactor30 = -vecmath_detail::determinant3x3( m01, m02, m03, m11, m12, m13, m21, m22, m23 );
+    T cofactor31 =  vecmath_detail::determinant3x3( m02, m03, m00, m12, m13, m10, m22, m23, m20 );
+    T cofactor32 = -vecmath_detail::determinant3x3( m03, m00, m01, m13, m10, m11, m23, m20, m21 );
+    T cofactor33 =  vecmath_detail::determinant3x3( m00, m01, m02, m10, m11, m12, m20, m21, m22 );
+
+	T determinant = m00 * cofactor00 + m01 * cofactor01 + m02 * cofactor02 + m03 * cofactor03;
+
+	bool isSingular = ( fabs( determinant ) < epsilon );
+	if( isSingular )
+	{
+		if( pbIsSingular != NULL )
+		{
+			*pbIsSingular = true;
+		}
+		return Matrix4< T >();
+	}
+	else
+	{
+		if( pbIsSingular != NULL )
+		{
+			*pbIsSingular = false;
+		}
+
+		T reciprocalDeterminant = 1.0f / determinant;
+
+		return Matrix4< T >
+			(
+				cofactor00 * reciprocalDeterminant, cofactor10 * reciprocalDeterminant, cofactor20 * reciprocalDeterminant, cofactor30 * reciprocalDeterminant,
+				cofactor01 * reciprocalDeterminant, cofactor11 * reciprocalDeterminant, cofactor21 * reciprocalDeterminant, cofactor31 * reciprocalDeterminant,
+				cofactor02 * reciprocalDeterminant, cofactor12 * reciprocalDeterminant, cofactor22 * reciprocalDeterminant, cofactor32 * reciprocalDeterminant,
+				cofactor03 * reciprocalDeterminant, cofactor13 * reciprocalDeterminant, cofactor23 * reciprocalDeterminant, cofactor33 * reciprocalDeterminant
+			);
+	}
+}
+
+template< typename T >
+Matrix4< T > Matrix4< T >::inverseAffine( bool* pbIsSingular, T epsilon ) const
+{
+	T inverseLinear[ 9 ];
+	bool isSingular = !vecmath_detail::inverse3x3( m_elements, inverseLinear, epsilon );
+	if( pbIsSingular != NULL )
+	{
+		*pbIsSingular = isSingular;
+	}
+	if( isSingular )
+	{
+		return Matrix4< T >();
+	}
+
+	const T* translation = m_elements + 12;
+
+	Matrix4< T > out = Matrix4< T >::identity();
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 3; ++j )
+		{
+			out( i, j ) = inverseLinear[ 3 * j + i ];
+		}
+		out( i, 3 ) = -( out( i, 0 ) * translation[ 0 ] + out( i, 1 ) * translation[ 1 ] + out( i, 2 ) * translation[ 2 ] );
+	}
+	return out;
+}
+
+template< typename T >
+Matrix4< T > Matrix4< T >::inverseRigid() const
+{
+	const T* translation = m_elements + 12;
+
+	Matrix4< T > out = Matrix4< T >::identity();
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 3; ++j )
+		{
+			out( i, j ) = ( *this )( j, i );
+		}
+		out( i, 3 ) = -( out( i, 0 ) * translation[ 0 ] + out( i, 1 ) * translation[ 1 ] + out( i, 2 ) * translation[ 2 ] );
+	}
+	return out;
+}
+
+template< typename T >
+Matrix4< T > Matrix4< T >::normalMatrix() const
+{
+	Matrix4< T > out = Matrix4< T >::identity();
+	T inverseLinear[ 9 ];
+	if( !vecmath_detail::inverse3x3( m_elements, inverseLinear, T( 0 ) ) )
+	{
+		// like Matrix3f::inverse(), a singular block becomes zero
+		for( int k = 0; k < 9; ++k )
+		{
+			inverseLinear[ k ] = 0;
+		}
+	}
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 3; ++j )
+		{
+			out( i, j ) = inverseLinear[ 3 * i + j ];
+		}
+	}
+	return out;
+}
+
+template< typename T >
+void Matrix4< T >::transpose()
+{
+	T temp;
+
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = i + 1; j < 4; ++j )
+		{
+			temp = ( *this )( i, j );
+			( * this )( i, j ) = ( *this )( j, i );
+			( *this )( j, i ) = temp;
+		}
+	}
+}
+
+template< typename T >
+Matrix4< T > Matrix4< T >::transposed() const
+{
+	Matrix4< T > out( *this );
+	out.transpose();
+	return out;
+}
+
+template< typename T >
+void Matrix4< T >::transformPoints( const Vector3< T >* in, Vector3< T >* out, int n ) const
+{
+	for( int i = 0; i < n; ++i )
+	{
+		T x = in[ i ][ 0 ];
+		T y = in[ i ][ 1 ];
+		T z = in[ i ][ 2 ];
+		for( int k = 0; k < 3; ++k )
+		{
+			out[ i ][ k ] = m_elements[ k ] * x + m_elements[ 4 + k ] * y + m_elements[ 8 + k ] * z + m_elements[ 12 + k ];
+		}
+	}
+}
+
+template< typename T >
+void Matrix4< T >::transformDirections( const Vector3< T >* in, Vector3< T >* out, int n ) const
+{
+	for( int i = 0; i < n; ++i )
+	{
+		T x = in[ i ][ 0 ];
+		T y = in[ i ][ 1 ];
+		T z = in[ i ][ 2 ];
+		for( int k = 0; k < 3; ++k )
+		{
+			out[ i ][ k ] = m_elements[ k ] * x + m_elements[ 4 + k ] * y + m_elements[ 8 + k ] * z;
+		}
+	}
+}
+
+template< typename T >
+void Matrix4< T >::accumulateTransformedPoints( const Vector3< T >* in, const T* weights, Vector3< T >* out, int n ) const
+{
+	for( int i = 0; i < n; ++i )
+	{
+		T x = in[ i ][ 0 ];
+		T y = in[ i ][ 1 ];
+		T z = in[ i ][ 2 ];
+		for( int k = 0; k < 3; ++k )
+		{
+			out[ i ][ k ] += weights[ i ] * ( m_elements[ k ] * x + m_elements[ 4 + k ] * y + m_elements[ 8 + k ] * z + m_elements[ 12 + k ] );
+		}
+	}
+}
+
+template< typename T >
+Matrix4< T >::operator T* ()
+{
+	return m_elements;
+}
+
+template< typename T >
+Matrix4< T >::operator const T* ()const
+{
+	return m_elements;
+}
+
+
+template< typename T >
+void Matrix4< T >::print()
+{
+	printf( "[ %.4f %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f %.4f ]\n[ %.4f %.4f %.4f %.4f ]\n",
+		m_elements[ 0 ], m_elements[ 4 ], m_elements[ 8 ], m_elements[ 12 ],
+		m_elements[ 1 ], m_elements[ 5 ], m_elements[ 9 ], m_elements[ 13 ],
+		m_elements[ 2 ], m_elements[ 6 ], m_elements[ 10], m_elements[ 14 ],
+		m_elements[ 3 ], m_elements[ 7 ], m_elements[ 11], m_elements[ 15 ] );
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::ones()
+{
+	Matrix4< T > m;
+	for( int i = 0; i < 16; ++i )
+	{
+		m.m_elements[ i ] = 1;
+	}
+
+	return m;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::identity()
+{
+	Matrix4< T > m;
+	
+	m( 0, 0 ) = 1;
+	m( 1, 1 ) = 1;
+	m( 2, 2 ) = 1;
+	m( 3, 3 ) = 1;
+
+	return m;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::translation( T x, T y, T z )
+{
+	return Matrix4< T >
+	(
+		1, 0, 0, x,
+		0, 1, 0, y,
+		0, 0, 1, z,
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::translation( const Vector3< T >& rTranslation )
+{
+	return Matrix4< T >
+	(
+		1, 0, 0, rTranslation.x(),
+		0, 1, 0, rTranslation.y(),
+		0, 0, 1, rTranslation.z(),
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::rotateX( T radians )
+{
+	T c = cos( radians );
+	T s = sin( radians );
+
+	return Matrix4< T >
+	(
+		1, 0, 0, 0,
+		0, c, -s, 0,
+		0, s, c, 0,
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::rotateY( T radians )
+{
+	T c = cos( radians );
+	T s = sin( radians );
+
+	return Matrix4< T >
+	(
+		c, 0, s, 0,
+		0, 1, 0, 0,
+		-s, 0, c, 0,
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::rotateZ( T radians )
+{
+	T c = cos( radians );
+	T s = sin( radians );
+
+	return Matrix4< T >
+	(
+		c, -s, 0, 0,
+		s, c, 0, 0,
+		0, 0, 1, 0,
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::rotation( const Vector3< T >& rDirection, T radians )
+{
+	Vector3< T > normalizedDirection = rDirection.normalized();
+	
+	T cosTheta = cos( radians );
+	T sinTheta = sin( radians );
+
+	T x = normalizedDirection.x();
+	T y = normalizedDirection.y();
+	T z = normalizedDirection.z();
+
+	return Matrix4< T >
+	(
+		x * x * ( 1.0f - cosTheta ) + cosTheta,			y * x * ( 1.0f - cosTheta ) - z * sinTheta,		z * x * ( 1.0f - cosTheta ) + y * sinTheta,		0.0f,
+		x * y * ( 1.0f - cosTheta ) + z * sinTheta,		y * y * ( 1.0f - cosTheta ) + cosTheta,			z * y * ( 1.0f - cosTheta ) - x * sinTheta,		0.0f,
+		x * z * ( 1.0f - cosTheta ) - y * sinTheta,		y * z * ( 1.0f - cosTheta ) + x * sinTheta,		z * z * ( 1.0f - cosTheta ) + cosTheta,			0.0f,
+		0.0f,											0.0f,											0.0f,											1.0f
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::rotation( const Quat4< T >& q )
+{
+	Quat4< T > qq = q.normalized();
+
+	T xx = qq.x() * qq.x();
+	T yy = qq.y() * qq.y();
+	T zz = qq.z() * qq.z();
+
+	T xy = qq.x() * qq.y();
+	T zw = qq.z() * qq.w();
+
+	T xz = qq.x() * qq.z();
+	T yw = qq.y() * qq.w();
+
+	T yz = qq.y() * qq.z();
+	T xw = qq.x() * qq.w();
+
+	return Matrix4< T >
+	(
+		1.0f - 2.0f * ( yy + zz ),		2.0f * ( xy - zw ),				2.0f * ( xz + yw ),				0.0f,
+		2.0f * ( xy + zw ),				1.0f - 2.0f * ( xx + zz ),		2.0f * ( yz - xw ),				0.0f,
+		2.0f * ( xz - yw ),				2.0f * ( yz + xw ),				1.0f - 2.0f * ( xx + yy ),		0.0f,
+		0.0f,							0.0f,							0.0f,							1.0f
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::scaling( T sx, T sy, T sz )
+{
+	return Matrix4< T >
+	(
+		sx, 0, 0, 0,
+		0, sy, 0, 0,
+		0, 0, sz, 0,
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::uniformScaling( T s )
+{
+	return Matrix4< T >
+	(
+		s, 0, 0, 0,
+		0, s, 0, 0,
+		0, 0, s, 0,
+		0, 0, 0, 1
+	);
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::randomRotation( T u0, T u1, T u2 )
+{
+	return Matrix4< T >::rotation( Quat4< T >::randomRotation( u0, u1, u2 ) );
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::lookAt( const Vector3< T >& eye, const Vector3< T >& center, const Vector3< T >& up )
+{
+	// z is negative forward
+	Vector3< T > z = ( eye - center ).normalized();
+	Vector3< T > y = up;
+	Vector3< T > x = Vector3< T >::cross( y, z );
+
+	// the x, y, and z vectors define the orthonormal coordinate system
+	// the affine part defines the overall translation
+	Matrix4< T > view;
+
+	for( int j = 0; j < 3; ++j )
+	{
+		view( 0, j ) = x[ j ];
+		view( 1, j ) = y[ j ];
+		view( 2, j ) = z[ j ];
+	}
+	view( 0, 3 ) = -Vector3< T >::dot( x, eye );
+	view( 1, 3 ) = -Vector3< T >::dot( y, eye );
+	view( 2, 3 ) = -Vector3< T >::dot( z, eye );
+	view( 3, 3 ) = 1;
+
+	return view;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::orthographicProjection( T width, T height, T zNear, T zFar, bool directX )
+{
+	Matrix4< T > m;
+
+	m( 0, 0 ) = 2.0f / width;
+	m( 1, 1 ) = 2.0f / height;
+	m( 3, 3 ) = 1.0f;
+
+	m( 0, 3 ) = -1;
+	m( 1, 3 ) = -1;
+
+	if( directX )
+	{
+		m( 2, 2 ) = 1.0f / ( zNear - zFar );
+		m( 2, 3 ) = zNear / ( zNear - zFar );
+	}
+	else
+	{
+		m( 2, 2 ) = 2.0f / ( zNear - zFar );
+		m( 2, 3 ) = ( zNear + zFar ) / ( zNear - zFar );
+	}
+
+	return m;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::orthographicProjection( T left, T right, T bottom, T top, T zNear, T zFar, bool directX )
+{
+	Matrix4< T > m;
+
+	m( 0, 0 ) = 2.0f / ( right - left );
+	m( 1, 1 ) = 2.0f / ( top - bottom );
+	m( 3, 3 ) = 1.0f;
+
+	m( 0, 3 ) = ( left + right ) / ( left - right );
+	m( 1, 3 ) = ( top + bottom ) / ( bottom - top );
+
+	if( directX )
+	{
+		m( 2, 2 ) = 1.0f / ( zNear - zFar );
+		m( 2, 3 ) = zNear / ( zNear - zFar );
+	}
+	else
+	{
+		m( 2, 2 ) = 2.0f / ( zNear - zFar );
+		m( 2, 3 ) = ( zNear + zFar ) / ( zNear - zFar );
+	}
+
+	return m;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::perspectiveProjection( T fLeft, T fRight,
+										 T fBottom, T fTop,
+										 T fZNear, T fZFar,
+										 bool directX )
+{
+	Matrix4< T > projection; // zero matrix
+
+	projection( 0, 0 ) = ( 2.0f * fZNear ) / ( fRight - fLeft );
+	projection( 1, 1 ) = ( 2.0f * fZNear ) / ( fTop - fBottom );
+	projection( 0, 2 ) = ( fRight + fLeft ) / ( fRight - fLeft );
+	projection( 1, 2 ) = ( fTop + fBottom ) / ( fTop - fBottom );
+	projection( 3, 2 ) = -1;
+
+	if( directX )
+	{
+		projection( 2, 2 ) = fZFar / ( fZNear - fZFar);
+		projection( 2, 3 ) = ( fZNear * fZFar ) / ( fZNear - fZFar );
+	}
+	else
+	{
+		projection( 2, 2 ) = ( fZNear + fZFar ) / ( fZNear - fZFar );
+		projection( 2, 3 ) = ( 2.0f * fZNear * fZFar ) / ( fZNear - fZFar );
+	}
+
+	return projection;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::perspectiveProjection( T fovYRadians, T aspect, T zNear, T zFar, bool directX )
+{
+	assert(zNear >= 0);
+	assert(zFar > 0);
+	Matrix4< T > m; // zero matrix
+
+	T yScale = 1 / std::tan( T( 0.5 ) * fovYRadians );
+	T xScale = yScale / aspect;
+
+	m( 0, 0 ) = xScale;
+	m( 1, 1 ) = yScale;
+	m( 3, 2 ) = -1;
+
+	if( directX )
+	{
+		m( 2, 2 ) = zFar / ( zNear - zFar );
+		m( 2, 3 ) = zNear * zFar / ( zNear - zFar );
+	}
+	else
+	{
+		m( 2, 2 ) = ( zFar + zNear ) / ( zNear - zFar );
+		m( 2, 3 ) = 2.f * zFar * zNear / ( zNear - zFar );
+	}
+
+	return m;
+}
+
+// static
+template< typename T >
+Matrix4< T > Matrix4< T >::infinitePerspectiveProjection( T fLeft, T fRight,
+												 T fBottom, T fTop,
+												 T fZNear, bool directX )
+{
+	Matrix4< T > projection;
+
+	projection( 0, 0 ) = ( 2.0f * fZNear ) / ( fRight - fLeft );
+	projection( 1, 1 ) = ( 2.0f * fZNear ) / ( fTop - fBottom );
+	projection( 0, 2 ) = ( fRight + fLeft ) / ( fRight - fLeft );
+	projection( 1, 2 ) = ( fTop + fBottom ) / ( fTop - fBottom );
+	projection( 3, 2 ) = -1;
+
+	// infinite view frustum
+	// just take the limit as far --> inf of the regular frustum
+	if( directX )
+	{
+		projection( 2, 2 ) = -1.0f;
+		projection( 2, 3 ) = -fZNear;		
+	}
+	else
+	{
+		projection( 2, 2 ) = -1.0f;
+		projection( 2, 3 ) = -2.0f * fZNear;
+	}
+
+	return projection;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+
+template< typename T >
+Vector4f operator * ( const Matrix4< T >& m, const Vector4f& v )
+{
+	Vector4f output( 0, 0, 0, 0 );
+
+	for( int i = 0; i < 4; ++i )
+	{
+		for( int j = 0; j < 4; ++j )
+		{
+			output[ i ] += m( i, j ) * v[ j ];
+		}
+	}
+
+	return output;
+}
+
+template< typename T >
+Matrix4< T > operator * ( const Matrix4< T >& x, const Matrix4< T >& y )
+{
+	Matrix4< T > product; // zeroes
+
+	for( int i = 0; i < 4; ++i )
+	{
+		for( int j = 0; j < 4; ++j )
+		{
+			for( int k = 0; k < 4; ++k )
+			{
+				product( i, k ) += x( i, j ) * y( j, k );
+			}
+		}
+	}
+
+	return product;
+}
+
+template< typename T >
+Matrix4< T > operator * ( const Matrix4< T >& m, typename Matrix4< T >::value_type f ) {
+	Matrix4< T > product(m); // zeroes
+
+	for( int i = 0; i < 4; ++i )
+	{
+		for( int j = 0; j < 4; ++j )
+		{
+            product(i, j) *= f;
+		}
+	}
+	return product;
+}
+template< typename T >
+Matrix4< T > operator * ( typename Matrix4< T >::value_type f, const Matrix4< T >& m ) {
+	Matrix4< T > product(m); // zeroes
+
+	for( int i = 0; i < 4; ++i )
+	{
+		for( int j = 0; j < 4; ++j )
+		{
+            product(i, j) *= f;
+		}
+	}
+	return product;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SSE/AVX versions for float
+//////////////////////////////////////////////////////////////////////////
+
+#if defined( VECMATH_SSE ) && !defined( VECMATH_EIGEN )
+
+// Cramer's rule on four columns at a time, after Intel's
+// "Streaming SIMD Extensions - Inverse of 4x4 Matrix" (AP-928).
+// The routine is written for row major input; feeding it our column major
+// storage inverts the transpose, which is the transpose of the inverse,
+// so the result comes out in column major order as well.
+template<>
+VECMATH_INLINE Matrix4f Matrix4< float >::inverse( bool* pbIsSingular, float epsilon ) const
+{
+	const float* src = m_elements;
+
+	__m128 minor0, minor1, minor2, minor3;
+	__m128 row0, row1, row2, row3;
+	__m128 det, tmp1;
+
+	tmp1 = _mm_setzero_ps();
+	row1 = _mm_setzero_ps();
+	row3 = _mm_setzero_ps();
+
+	tmp1 = _mm_loadh_pi( _mm_loadl_pi( tmp1, ( const __m64* )( src ) ), ( const __m64* )( src + 4 ) );
+	row1 = _mm_loadh_pi( _mm_loadl_pi( row1, ( const __m64* )( src + 8 ) ), ( const __m64* )( src + 12 ) );
+	row0 = _mm_shuffle_ps( tmp1, row1, 0x88 );
+	row1 = _mm_shuffle_ps( row1, tmp1, 0xDD );
+	tmp1 = _mm_loadh_pi( _mm_loadl_pi( tmp1, ( const __m64* )( src + 2 ) ), ( const __m64* )( src + 6 ) );
+	row3 = _mm_loadh_pi( _mm_loadl_pi( row3, ( const __m64* )( src + 10 ) ), ( const __m64* )( src + 14 ) );
+	row2 = _mm_shuffle_ps( tmp1, row3, 0x88 );
+	row3 = _mm_shuffle_ps( row3, tmp1, 0xDD );
+
+	tmp1 = _mm_mul_ps( row2, row3 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0xB1 );
+	minor0 = _mm_mul_ps( row1, tmp1 );
+	minor1 = _mm_mul_ps( row0, tmp1 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0x4E );
+	minor0 = _mm_sub_ps( _mm_mul_ps( row1, tmp1 ), minor0 );
+	minor1 = _mm_sub_ps( _mm_mul_ps( row0, tmp1 ), minor1 );
+	minor1 = _mm_shuffle_ps( minor1, minor1, 0x4E );
+
+	tmp1 = _mm_mul_ps( row1, row2 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0xB1 );
+	minor0 = _mm_add_ps( _mm_mul_ps( row3, tmp1 ), minor0 );
+	minor3 = _mm_mul_ps( row0, tmp1 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0x4E );
+	minor0 = _mm_sub_ps( minor0, _mm_mul_ps( row3, tmp1 ) );
+	minor3 = _mm_sub_ps( _mm_mul_ps( row0, tmp1 ), minor3 );
+	minor3 = _mm_shuffle_ps( minor3, minor3, 0x4E );
+
+	tmp1 = _mm_mul_ps( _mm_shuffle_ps( row1, row1, 0x4E ), row3 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0xB1 );
+	row2 = _mm_shuffle_ps( row2, row2, 0x4E );
+	minor0 = _mm_add_ps( _mm_mul_ps( row2, tmp1 ), minor0 );
+	minor2 = _mm_mul_ps( row0, tmp1 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0x4E );
+	minor0 = _mm_sub_ps( minor0, _mm_mul_ps( row2, tmp1 ) );
+	minor2 = _mm_sub_ps( _mm_mul_ps( row0, tmp1 ), minor2 );
+	minor2 = _mm_shuffle_ps( minor2, minor2, 0x4E );
+
+	tmp1 = _mm_mul_ps( row0, row1 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0xB1 );
+	minor2 = _mm_add_ps( _mm_mul_ps( row3, tmp1 ), minor2 );
+	minor3 = _mm_sub_ps( _mm_mul_ps( row2, tmp1 ), minor3 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0x4E );
+	minor2 = _mm_sub_ps( _mm_mul_ps( row3, tmp1 ), minor2 );
+	minor3 = _mm_sub_ps( minor3, _mm_mul_ps( row2, tmp1 ) );
+
+	tmp1 = _mm_mul_ps( row0, row3 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0xB1 );
+	minor1 = _mm_sub_ps( minor1, _mm_mul_ps( row2, tmp1 ) );
+	minor2 = _mm_add_ps( _mm_mul_ps( row1, tmp1 ), minor2 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0x4E );
+	minor1 = _mm_add_ps( _mm_mul_ps( row2, tmp1 ), minor1 );
+	minor2 = _mm_sub_ps( minor2, _mm_mul_ps( row1, tmp1 ) );
+
+	tmp1 = _mm_mul_ps( row0, row2 );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0xB1 );
+	minor1 = _mm_add_ps( _mm_mul_ps( row3, tmp1 ), minor1 );
+	minor3 = _mm_sub_ps( minor3, _mm_mul_ps( row1, tmp1 ) );
+	tmp1 = _mm_shuffle_ps( tmp1, tmp1, 0x4E );
+	minor1 = _mm_sub_ps( minor1, _mm_mul_ps( row3, tmp1 ) );
+	minor3 = _mm_add_ps( _mm_mul_ps( row1, tmp1 ), minor3 );
+
+	det = _mm_mul_ps( row0, minor0 );
+	det = _mm_add_ps( _mm_shuffle_ps( det, det, 0x4E ), det );
+	det = _mm_add_ss( _mm_shuffle_ps( det, det, 0xB1 ), det );
+
+	float determinant = _mm_cvtss_f32( det );
+
+	bool isSingular = ( fabs( determinant ) < epsilon );
+	if( pbIsSingular != NULL )
+	{
+		*pbIsSingular = isSingular;
+	}
+	if( isSingular )
+	{
+		return Matrix4f();
+	}
+
+	// use an exact reciprocal rather than _mm_rcp_ss so that results
+	// stay within rounding error of the scalar implementation
+	det = _mm_set1_ps( 1.0f / determinant );
+
+	Matrix4f out;
+	_mm_storeu_ps( out.m_elements, _mm_mul_ps( det, minor0 ) );
+	_mm_storeu_ps( out.m_elements + 4, _mm_mul_ps( det, minor1 ) );
+	_mm_storeu_ps( out.m_elements + 8, _mm_mul_ps( det, minor2 ) );
+	_mm_storeu_ps( out.m_elements + 12, _mm_mul_ps( det, minor3 ) );
+	return out;
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::transpose()
+{
+	__m128 c0 = _mm_loadu_ps( m_elements );
+	__m128 c1 = _mm_loadu_ps( m_elements + 4 );
+	__m128 c2 = _mm_loadu_ps( m_elements + 8 );
+	__m128 c3 = _mm_loadu_ps( m_elements + 12 );
+
+	_MM_TRANSPOSE4_PS( c0, c1, c2, c3 );
+
+	_mm_storeu_ps( m_elements, c0 );
+	_mm_storeu_ps( m_elements + 4, c1 );
+	_mm_storeu_ps( m_elements + 8, c2 );
+	_mm_storeu_ps( m_elements + 12, c3 );
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::transformPoints( const Vector3f* in, Vector3f* out, int n ) const
+{
+	__m128 c0 = _mm_loadu_ps( m_elements );
+	__m128 c1 = _mm_loadu_ps( m_elements + 4 );
+	__m128 c2 = _mm_loadu_ps( m_elements + 8 );
+	__m128 c3 = _mm_loadu_ps( m_elements + 12 );
+
+	for( int i = 0; i < n; ++i )
+	{
+		const float* p = in[ i ];
+		__m128 r = _mm_mul_ps( c0, _mm_set1_ps( p[ 0 ] ) );
+		r = _mm_add_ps( r, _mm_mul_ps( c1, _mm_set1_ps( p[ 1 ] ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( c2, _mm_set1_ps( p[ 2 ] ) ) );
+		r = _mm_add_ps( r, c3 );
+		vecmath_sse::store3( out[ i ], r );
+	}
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::transformDirections( const Vector3f* in, Vector3f* out, int n ) const
+{
+	__m128 c0 = _mm_loadu_ps( m_elements );
+	__m128 c1 = _mm_loadu_ps( m_elements + 4 );
+	__m128 c2 = _mm_loadu_ps( m_elements + 8 );
+
+	for( int i = 0; i < n; ++i )
+	{
+		const float* p = in[ i ];
+		__m128 r = _mm_mul_ps( c0, _mm_set1_ps( p[ 0 ] ) );
+		r = _mm_add_ps( r, _mm_mul_ps( c1, _mm_set1_ps( p[ 1 ] ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( c2, _mm_set1_ps( p[ 2 ] ) ) );
+		vecmath_sse::store3( out[ i ], r );
+	}
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::accumulateTransformedPoints( const Vector3f* in, const float* weights, Vector3f* out, int n ) const
+{
+	__m128 c0 = _mm_loadu_ps( m_elements );
+	__m128 c1 = _mm_loadu_ps( m_elements + 4 );
+	__m128 c2 = _mm_loadu_ps( m_elements + 8 );
+	__m128 c3 = _mm_loadu_ps( m_elements + 12 );
+
+	for( int i = 0; i < n; ++i )
+	{
+		const float* p = in[ i ];
+		__m128 r = _mm_mul_ps( c0, _mm_set1_ps( p[ 0 ] ) );
+		r = _mm_add_ps( r, _mm_mul_ps( c1, _mm_set1_ps( p[ 1 ] ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( c2, _mm_set1_ps( p[ 2 ] ) ) );
+		r = _mm_add_ps( r, c3 );
+		r = _mm_mul_ps( _mm_set1_ps( weights[ i ] ), r );
+		vecmath_sse::store3( out[ i ], _mm_add_ps( vecmath_sse::load3( out[ i ] ), r ) );
+	}
+}
+
+template<>
+VECMATH_INLINE Vector4f operator * ( const Matrix4< float >& m, const Vector4f& v )
+{
+	// linear combination of the columns of m
+	const float* pm = m;
+	const float* pv = v;
+
+	__m128 r = _mm_mul_ps( _mm_loadu_ps( pm ), _mm_set1_ps( pv[ 0 ] ) );
+	r = _mm_add_ps( r, _mm_mul_ps( _mm_loadu_ps( pm + 4 ), _mm_set1_ps( pv[ 1 ] ) ) );
+	r = _mm_add_ps( r, _mm_mul_ps( _mm_loadu_ps( pm + 8 ), _mm_set1_ps( pv[ 2 ] ) ) );
+	r = _mm_add_ps( r, _mm_mul_ps( _mm_loadu_ps( pm + 12 ), _mm_set1_ps( pv[ 3 ] ) ) );
+
+	Vector4f output;
+	_mm_storeu_ps( output, r );
+	return output;
+}
+
+template<>
+VECMATH_INLINE Matrix4f operator * ( const Matrix4< float >& x, const Matrix4< float >& y )
+{
+#if defined( VECMATH_AVX )
+	// two columns of the product per iteration:
+	// column k of x * y is the combination of the columns of x weighted by column k of y
+	const float* px = x;
+	const float* py = y;
+
+	__m256 a0 = _mm256_broadcast_ps( ( const __m128* )( px ) );
+	__m256 a1 = _mm256_broadcast_ps( ( const __m128* )( px + 4 ) );
+	__m256 a2 = _mm256_broadcast_ps( ( const __m128* )( px + 8 ) );
+	__m256 a3 = _mm256_broadcast_ps( ( const __m128* )( px + 12 ) );
+
+	Matrix4f product;
+	float* pp = product;
+	for( int k = 0; k < 4; k += 2 )
+	{
+		__m256 b = _mm256_loadu_ps( py + 4 * k );
+
+		__m256 r = _mm256_mul_ps( a0, _mm256_shuffle_ps( b, b, 0x00 ) );
+		r = _mm256_add_ps( r, _mm256_mul_ps( a1, _mm256_shuffle_ps( b, b, 0x55 ) ) );
+		r = _mm256_add_ps( r, _mm256_mul_ps( a2, _mm256_shuffle_ps( b, b, 0xAA ) ) );
+		r = _mm256_add_ps( r, _mm256_mul_ps( a3, _mm256_shuffle_ps( b, b, 0xFF ) ) );
+
+		_mm256_storeu_ps( pp + 4 * k, r );
+	}
+
+	return product;
+#else
+	// column k of x * y is the combination of the columns of x weighted by column k of y
+	const float* px = x;
+	const float* py = y;
+
+	__m128 a0 = _mm_loadu_ps( px );
+	__m128 a1 = _mm_loadu_ps( px + 4 );
+	__m128 a2 = _mm_loadu_ps( px + 8 );
+	__m128 a3 = _mm_loadu_ps( px + 12 );
+
+	Matrix4f product;
+	float* pp = product;
+	for( int k = 0; k < 4; ++k )
+	{
+		const float* b = py + 4 * k;
+
+		__m128 r = _mm_mul_ps( a0, _mm_set1_ps( b[ 0 ] ) );
+		r = _mm_add_ps( r, _mm_mul_ps( a1, _mm_set1_ps( b[ 1 ] ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( a2, _mm_set1_ps( b[ 2 ] ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( a3, _mm_set1_ps( b[ 3 ] ) ) );
+
+		_mm_storeu_ps( pp + 4 * k, r );
+	}
+
+	return product;
+#endif
+}
+
+#endif // VECMATH_SSE && !VECMATH_EIGEN
+
+//////////////////////////////////////////////////////////////////////////
+// Eigen versions for float, see vecmath_eigen.h
+//////////////////////////////////////////////////////////////////////////
+
+#ifdef VECMATH_EIGEN
+
+template<>
+VECMATH_INLINE Matrix4f Matrix4< float >::inverse( bool* pbIsSingular, float epsilon ) const
+{
+	// an aligned copy lets Eigen use its SSE 4x4 inverse
+	Eigen::Matrix4f m = vecmath_eigen::ConstMatrix4Map( m_elements );
+	float determinant = m.determinant();
+
+	bool isSingular = ( fabs( determinant ) < epsilon );
+	if( pbIsSingular != NULL )
+	{
+		*pbIsSingular = isSingular;
+	}
+	if( isSingular )
+	{
+		return Matrix4f();
+	}
+
+	Matrix4f out;
+	vecmath_eigen::Matrix4Map result( out.m_elements );
+	result = m.inverse();
+	return out;
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::transpose()
+{
+	vecmath_eigen::Matrix4Map( m_elements ).transposeInPlace();
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::transformPoints( const Vector3f* in, Vector3f* out, int n ) const
+{
+	vecmath_eigen::ConstMatrix4Map m( m_elements );
+	for( int i = 0; i < n; ++i )
+	{
+		vecmath_eigen::Vector3Map result( out[ i ] );
+		result = m.topLeftCorner< 3, 3 >() * vecmath_eigen::ConstVector3Map( in[ i ] ) + m.topRightCorner< 3, 1 >();
+	}
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::transformDirections( const Vector3f* in, Vector3f* out, int n ) const
+{
+	vecmath_eigen::ConstMatrix4Map m( m_elements );
+	for( int i = 0; i < n; ++i )
+	{
+		vecmath_eigen::Vector3Map result( out[ i ] );
+		result = m.topLeftCorner< 3, 3 >() * vecmath_eigen::ConstVector3Map( in[ i ] );
+	}
+}
+
+template<>
+VECMATH_INLINE void Matrix4< float >::accumulateTransformedPoints( const Vector3f* in, const float* weights, Vector3f* out, int n ) const
+{
+	vecmath_eigen::ConstMatrix4Map m( m_elements );
+	for( int i = 0; i < n; ++i )
+	{
+		vecmath_eigen::Vector3Map result( out[ i ] );
+		result += weights[ i ] * ( m.topLeftCorner< 3, 3 >() * vecmath_eigen::ConstVector3Map( in[ i ] ) + m.topRightCorner< 3, 1 >() );
+	}
+}
+
+template<>
+VECMATH_INLINE Vector4f operator * ( const Matrix4< float >& m, const Vector4f& v )
+{
+	Vector4f output;
+	vecmath_eigen::Vector4Map result( output );
+	result = vecmath_eigen::ConstMatrix4Map( m ) * vecmath_eigen::ConstVector4Map( v );
+	return output;
+}
+
+template<>
+VECMATH_INLINE Matrix4f operator * ( const Matrix4< float >& x, const Matrix4< float >& y )
+{
+	// Eigen only vectorizes the product of aligned matrices
+	Eigen::Matrix4f a = vecmath_eigen::ConstMatrix4Map( x );
+	Eigen::Matrix4f b = vecmath_eigen::ConstMatrix4Map( y );
+
+	Matrix4f product;
+	vecmath_eigen::Matrix4Map result( product );
+	result.noalias() = a * b;
+	return product;
+}
+
+#endif // VECMATH_EIGEN
+
+#endif // MATRIX4F_INL
@@ -0,0 +1,143 @@
+#ifndef QUAT4F_H
+#define QUAT4F_H
+
+#include "vecmath_fwd.h"
+#include "vecmath_inline.h"
+
+class Matrix3f;
+class Vector4f;
+
+// Quaternion, Quat4f for float and Quat4d for double
+template< typename T >
+class Quat4
+{
+public:
+
+	typedef T value_type;
+
+	static const Quat4 ZERO;
+	static const Quat4 IDENTITY;
+
+	Quat4();
+
+	// q = w + x * i + y * j + z * k
+	Quat4( T w, T x, T y, T z );
+		
+	Quat4( const Quat4& rq ); // copy constructor
+
+	// converts from another precision, e.g. Quat4f( Quat4d( ... ) )
+	template< typename U >
+	explicit Quat4( const Quat4< U >& rq );
+
+	Quat4& operator = ( const Quat4& rq ); // assignment operator
+	// no destructor necessary
+
+	// returns a quaternion with 0 real part
+	Quat4( const Vector3< T >& v );
+
+	// copies the components of a Vector4f directly into this quaternion
+	Quat4( const Vector4f& v );
+
+	// returns the ith element
+	const T& operator [] ( int i ) const;
+	T& operator [] ( int i );
+
+	T w() const;
+	T x() const;
+	T y() const;
+	T z() const;
+	Vector3< T > xyz() const;
+	Vector4f wxyz() const;
+
+	T abs() const;
+	T absSquared() const;
+	void normalize();
+	Quat4 normalized() const;
+
+	void conjugate();
+	Quat4 conjugated() const;
+
+	void invert();
+	Quat4 inverse() const;
+
+	// log and exponential maps
+	Quat4 log() const;
+	Quat4 exp() const;
+	
+	// returns unit vector for rotation and radians about the unit vector
+	Vector3< T > getAxisAngle( T* radiansOut );
+
+	// sets this quaternion to be a rotation of fRadians about v = < fx, fy, fz >, v need not necessarily be unit length
+	void setAxisAngle( T radians, const Vector3< T >& axis );
+
+	// ---- Utility ----
+	void print();
+ 
+	 // quaternion dot product (a la vector)
+	static T dot( const Quat4& q0, const Quat4& q1 );	
+	
+	// linear (stupid) interpolation
+	static Quat4 lerp( const Quat4& q0, const Quat4& q1, T alpha );
+
+	// spherical linear interpolation
+	static Quat4 slerp( const Quat4& a, const Quat4& b, T t, bool allowFlip = true );
+	
+	// spherical quadratic interoplation between a and b at point t
+	// given quaternion tangents tanA and tanB (can be computed using squadTangent)	
+	static Quat4 squad( const Quat4& a, const Quat4& tanA, const Quat4& tanB, const Quat4& b, T t );
+
+	static Quat4 cubicInterpolate( const Quat4& q0, const Quat4& q1, const Quat4& q2, const Quat4& q3, T t );
+
+	// Log-difference between a and b, used for squadTangent
+	// returns log( a^-1 b )	
+	static Quat4 logDifference( const Quat4& a, const Quat4& b );
+
+	// Computes a tangent at center, defined by the before and after quaternions
+	// Useful for squad()
+	static Quat4 squadTangent( const Quat4& before, const Quat4& center, const Quat4& after );		
+
+	static Quat4 fromRotationMatrix( const Matrix3f& m );
+
+	static Quat4 fromRotatedBasis( const Vector3< T >& x, const Vector3< T >& y, const Vector3< T >& z );
+
+	// returns a unit quaternion that's a uniformly distributed rotation
+	// given u[i] is a uniformly distributed random number in [0,1]
+	// taken from Graphics Gems II
+	static Quat4 randomRotation( T u0, T u1, T u2 );
+
+private:
+
+	T m_elements[ 4 ];
+
+};
+
+template< typename T > Quat4< T > operator + ( const Quat4< T >& q0, const Quat4< T >& q1 );
+template< typename T > Quat4< T > operator - ( const Quat4< T >& q0, const Quat4< T >& q1 );
+template< typename T > Quat4< T > operator * ( const Quat4< T >& q0, const Quat4< T >& q1 );
+template< typename T > Quat4< T > operator * ( typename Quat4< T >::value_type f, const Quat4< T >& q );
+template< typename T > Quat4< T > operator * ( const Quat4< T >& q, typename Quat4< T >::value_type f );
+
+#ifdef VECMATH_EIGEN
+// Eigen version for float, defined at the end of Quat4f.inl
+template<> VECMATH_INLINE Quat4< float > operator * ( const Quat4< float >& q0, const Quat4< float >& q1 );
+#endif
+
+// defined here in both build modes, see Vector3f.h
+template< typename T >
+template< typename U >
+Quat4< T >::Quat4( const Quat4< U >& rq )
+{
+	m_elements[ 0 ] = static_cast< T >( rq[ 0 ] );
+	m_elements[ 1 ] = static_cast< T >( rq[ 1 ] );
+	m_elements[ 2 ] = static_cast< T >( rq[ 2 ] );
+	m_elements[ 3 ] = static_cast< T >( rq[ 3 ] );
+}
+
+// kept for code that relies on Quat4f.h providing Matrix3f
+#include "Matrix3f.h"
+
+#ifdef VECMATH_HEADER_ONLY
+#include "Quat4f.inl"
+#endif
+
+#endif // QUAT4F_H
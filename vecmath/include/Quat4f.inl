@@ -0,0 +1,564 @@
+#ifndef QUAT4F_INL
+#define QUAT4F_INL
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#include <cstdio>
+
+#include "Quat4f.h"
+#include "Vector3f.h"
+#include "Vector4f.h"
+#include "vecmath_eigen.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Public
+//////////////////////////////////////////////////////////////////////////
+
+template< typename T >
+Quat4< T >::Quat4()
+{
+	m_elements[ 0 ] = 0;
+	m_elements[ 1 ] = 0;
+	m_elements[ 2 ] = 0;
+	m_elements[ 3 ] = 0;
+}
+
+template< typename T >
+Quat4< T >::Quat4( T w, T x, T y, T z )
+{
+	m_elements[ 0 ] = w;
+	m_elements[ 1 ] = x;
+	m_elements[ 2 ] = y;
+	m_elements[ 3 ] = z;
+}
+
+template< typename T >
+Quat4< T >::Quat4( const Quat4< T >& rq )
+{
+	m_elements[ 0 ] = rq.m_elements[ 0 ];
+	m_elements[ 1 ] = rq.m_elements[ 1 ];
+	m_elements[ 2 ] = rq.m_elements[ 2 ];
+	m_elements[ 3 ] = rq.m_elements[ 3 ];
+}
+
+template< typename T >
+Quat4< T >& Quat4< T >::operator = ( const Quat4< T >& rq )
+{
+	if( this != ( &rq ) )
+	{
+		m_elements[ 0 ] = rq.m_elements[ 0 ];
+		m_elements[ 1 ] = rq.m_elements[ 1 ];
+		m_elements[ 2 ] = rq.m_elements[ 2 ];
+		m_elements[ 3 ] = rq.m_elements[ 3 ];
+	}
+    return( *this );
+}
+
+template< typename T >
+Quat4< T >::Quat4( const Vector3< T >& v )
+{
+	m_elements[ 0 ] = 0;
+	m_elements[ 1 ] = v[ 0 ];
+	m_elements[ 2 ] = v[ 1 ];
+	m_elements[ 3 ] = v[ 2 ];
+}
+
+template< typename T >
+Quat4< T >::Quat4( const Vector4f& v )
+{
+	m_elements[ 0 ] = v[ 0 ];
+	m_elements[ 1 ] = v[ 1 ];
+	m_elements[ 2 ] = v[ 2 ];
+	m_elements[ 3 ] = v[ 3 ];
+}
+
+template< typename T >
+const T& Quat4< T >::operator [] ( int i ) const
+{
+	return m_elements[ i ];
+}
+
+template< typename T >
+T& Quat4< T >::operator [] ( int i )
+{
+	return m_elements[ i ];
+}
+
+template< typename T >
+T Quat4< T >::w() const
+{
+	return m_elements[ 0 ];
+}
+
+template< typename T >
+T Quat4< T >::x() const
+{
+	return m_elements[ 1 ];
+}
+
+template< typename T >
+T Quat4< T >::y() const
+{
+	return m_elements[ 2 ];
+}
+
+template< typename T >
+T Quat4< T >::z() const
+{
+	return m_elements[ 3 ];
+}
+
+template< typename T >
+Vector3< T > Quat4< T >::xyz() const
+{
+	return Vector3< T >
+	(
+		m_elements[ 1 ],
+		m_elements[ 2 ],
+		m_elements[ 3 ]
+	);
+}
+
+template< typename T >
+Vector4f Quat4< T >::wxyz() const
+{
+	return Vector4f
+	(
+		m_elements[ 0 ],
+		m_elements[ 1 ],
+		m_elements[ 2 ],
+		m_elements[ 3 ]
+	);
+}
+
+template< typename T >
+T Quat4< T >::abs() const
+{
+	return sqrt( absSquared() );	
+}
+
+template< typename T >
+T Quat4< T >::absSquared() const
+{
+	return
+	(
+		m_elements[ 0 ] * m_elements[ 0 ] +
+		m_elements[ 1 ] * m_elements[ 1 ] +
+		m_elements[ 2 ] * m_elements[ 2 ] +
+		m_elements[ 3 ] * m_elements[ 3 ]
+	);
+}
+
+template< typename T >
+void Quat4< T >::normalize()
+{
+	T reciprocalAbs = 1.f / abs();
+
+	m_elements[ 0 ] *= reciprocalAbs;
+	m_elements[ 1 ] *= reciprocalAbs;
+	m_elements[ 2 ] *= reciprocalAbs;
+	m_elements[ 3 ] *= reciprocalAbs;
+}
+
+template< typename T >
+Quat4< T > Quat4< T >::normalized() const
+{
+	Quat4< T > q( *this );
+	q.normalize();
+	return q;
+}
+
+template< typename T >
+void Quat4< T >::conjugate()
+{
+	m_elements[ 1 ] = -m_elements[ 1 ];
+	m_elements[ 2 ] = -m_elements[ 2 ];
+	m_elements[ 3 ] = -m_elements[ 3 ];
+}
+
+template< typename T >
+Quat4< T > Quat4< T >::conjugated() const
+{
+	return Quat4< T >
+	(
+		 m_elements[ 0 ],
+		-m_elements[ 1 ],
+		-m_elements[ 2 ],
+		-m_elements[ 3 ]
+	);
+}
+
+template< typename T >
+void Quat4< T >::invert()
+{
+	Quat4< T > inverse = conjugated() * ( 1.0f / absSquared() );
+
+	m_elements[ 0 ] = inverse.m_elements[ 0 ];
+	m_elements[ 1 ] = inverse.m_elements[ 1 ];
+	m_elements[ 2 ] = inverse.m_elements[ 2 ];
+	m_elements[ 3 ] = inverse.m_elements[ 3 ];
+}
+
+template< typename T >
+Quat4< T > Quat4< T >::inverse() const
+{
+	return conjugated() * ( 1.0f / absSquared() );
+}
+
+
+template< typename T >
+Quat4< T > Quat4< T >::log() const
+{
+	T len =
+		sqrt
+		(
+			m_elements[ 1 ] * m_elements[ 1 ] +
+			m_elements[ 2 ] * m_elements[ 2 ] +
+			m_elements[ 3 ] * m_elements[ 3 ]
+		);
+
+	if( len < 1e-6 )
+	{
+		return Quat4< T >( 0, m_elements[ 1 ], m_elements[ 2 ], m_elements[ 3 ] );
+	}
+	else
+	{
+		T coeff = acos( m_elements[ 0 ] ) / len;
+		return Quat4< T >( 0, m_elements[ 1 ] * coeff, m_elements[ 2 ] * coeff, m_elements[ 3 ] * coeff );
+	}
+}
+
+template< typename T >
+Quat4< T > Quat4< T >::exp() const
+{
+	T theta =
+		sqrt
+		(
+			m_elements[ 1 ] * m_elements[ 1 ] +
+			m_elements[ 2 ] * m_elements[ 2 ] +
+			m_elements[ 3 ] * m_elements[ 3 ]
+		);
+
+	if( theta < 1e-6 )
+	{
+		return Quat4< T >( cos( theta ), m_elements[ 1 ], m_elements[ 2 ], m_elements[ 3 ] );
+	}
+	else
+	{
+		T coeff = sin( theta ) / theta;
+		return Quat4< T >( cos( theta ), m_elements[ 1 ] * coeff, m_elements[ 2 ] * coeff, m_elements[ 3 ] * coeff );		
+	}
+}
+
+template< typename T >
+Vector3< T > Quat4< T >::getAxisAngle( T* radiansOut )
+{
+	T theta = acos( w() ) * 2;
+	T vectorNorm = sqrt( x() * x() + y() * y() + z() * z() );
+	T reciprocalVectorNorm = 1.f / vectorNorm;
+
+	*radiansOut = theta;
+	return Vector3< T >
+	(
+		x() * reciprocalVectorNorm,
+		y() * reciprocalVectorNorm,
+		z() * reciprocalVectorNorm
+	);
+}
+
+template< typename T >
+void Quat4< T >::setAxisAngle( T radians, const Vector3< T >& axis )
+{
+	m_elements[ 0 ] = cos( radians / 2 );
+
+	T sinHalfTheta = sin( radians / 2 );
+	T vectorNorm = axis.abs();
+	T reciprocalVectorNorm = 1.f / vectorNorm;
+
+	m_elements[ 1 ] = axis.x() * sinHalfTheta * reciprocalVectorNorm;
+	m_elements[ 2 ] = axis.y() * sinHalfTheta * reciprocalVectorNorm;
+	m_elements[ 3 ] = axis.z() * sinHalfTheta * reciprocalVectorNorm;
+}
+
+template< typename T >
+void Quat4< T >::print()
+{
+	printf( "< %.4f + %.4f i + %.4f j + %.4f k >\n",
+		m_elements[ 0 ], m_elements[ 1 ], m_elements[ 2 ], m_elements[ 3 ] );
+}
+
+// static
+template< typename T >
+T Quat4< T >::dot( const Quat4< T >& q0, const Quat4< T >& q1 )
+{
+	return
+	(
+		q0.w() * q1.w() +
+		q0.x() * q1.x() +
+		q0.y() * q1.y() +
+		q0.z() * q1.z()
+	);
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::lerp( const Quat4< T >& q0, const Quat4< T >& q1, T alpha )
+{
+	return( ( q0 + alpha * ( q1 - q0 ) ).normalized() );
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::slerp( const Quat4< T >& a, const Quat4< T >& b, T t, bool allowFlip )
+{
+	T cosAngle = Quat4< T >::dot( a, b );
+
+	T c1;
+	T c2;
+
+	// Linear interpolation for close orientations
+	if( ( 1.0f - fabs( cosAngle ) ) < 0.01f )
+	{
+		c1 = 1.0f - t;
+		c2 = t;
+	}
+	else
+	{
+		// Spherical interpolation
+		T angle = acos( fabs( cosAngle ) );
+		T sinAngle = sin( angle );
+		c1 = sin( angle * ( 1.0f - t ) ) / sinAngle;
+		c2 = sin( angle * t ) / sinAngle;
+	}
+
+	// Use the shortest path
+	if( allowFlip && ( cosAngle < 0.0f ) )
+	{
+		c1 = -c1;
+	}
+
+	return Quat4< T >( c1 * a[ 0 ] + c2 * b[ 0 ], c1 * a[ 1 ] + c2 * b[ 1 ], c1 * a[ 2 ] + c2 * b[ 2 ], c1 * a[ 3 ] + c2 * b[ 3 ] );
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::squad( const Quat4< T >& a, const Quat4< T >& tanA, const Quat4< T >& tanB, const Quat4< T >& b, T t )
+{
+	Quat4< T > ab = Quat4< T >::slerp( a, b, t );
+	Quat4< T > tangent = Quat4< T >::slerp( tanA, tanB, t, false );
+	return Quat4< T >::slerp( ab, tangent, 2.0f * t * ( 1.0f - t ), false );
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::cubicInterpolate( const Quat4< T >& q0, const Quat4< T >& q1, const Quat4< T >& q2, const Quat4< T >& q3, T t )
+{
+	// geometric construction:
+	//            t
+	//   (t+1)/2     t/2
+	// t+1        t	        t-1
+
+	// bottom level
+	Quat4< T > q0q1 = Quat4< T >::slerp( q0, q1, t + 1 );
+	Quat4< T > q1q2 = Quat4< T >::slerp( q1, q2, t );
+	Quat4< T > q2q3 = Quat4< T >::slerp( q2, q3, t - 1 );
+
+	// middle level
+	Quat4< T > q0q1_q1q2 = Quat4< T >::slerp( q0q1, q1q2, 0.5f * ( t + 1 ) );
+	Quat4< T > q1q2_q2q3 = Quat4< T >::slerp( q1q2, q2q3, 0.5f * t );
+
+	// top level
+	return Quat4< T >::slerp( q0q1_q1q2, q1q2_q2q3, t );
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::logDifference( const Quat4< T >& a, const Quat4< T >& b )
+{
+	Quat4< T > diff = a.inverse() * b;
+	diff.normalize();
+	return diff.log();
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::squadTangent( const Quat4< T >& before, const Quat4< T >& center, const Quat4< T >& after )
+{
+	Quat4< T > l1 = Quat4< T >::logDifference( center, before );
+	Quat4< T > l2 = Quat4< T >::logDifference( center, after );
+	
+	Quat4< T > e;
+	for( int i = 0; i < 4; ++i )
+	{
+		e[ i ] = -0.25f * ( l1[ i ] + l2[ i ] );
+	}
+	e = center * ( e.exp() );
+
+	return e;
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::fromRotationMatrix( const Matrix3f& m )
+{
+	T x;
+	T y;
+	T z;
+	T w;
+
+	// Compute one plus the trace of the matrix
+	T onePlusTrace = 1.0f + m( 0, 0 ) + m( 1, 1 ) + m( 2, 2 );
+
+	if( onePlusTrace > 1e-5 )
+	{
+		// Direct computation
+		T s = sqrt( onePlusTrace ) * 2.0f;
+		x = ( m( 2, 1 ) - m( 1, 2 ) ) / s;
+		y = ( m( 0, 2 ) - m( 2, 0 ) ) / s;
+		z = ( m( 1, 0 ) - m( 0, 1 ) ) / s;
+		w = 0.25f * s;
+	}
+	else
+	{
+		// Computation depends on major diagonal term
+		if( ( m( 0, 0 ) > m( 1, 1 ) ) & ( m( 0, 0 ) > m( 2, 2 ) ) )
+		{
+			T s = sqrt( 1.0f + m( 0, 0 ) - m( 1, 1 ) - m( 2, 2 ) ) * 2.0f;
+			x = 0.25f * s;
+			y = ( m( 0, 1 ) + m( 1, 0 ) ) / s;
+			z = ( m( 0, 2 ) + m( 2, 0 ) ) / s;
+			w = ( m( 1, 2 ) - m( 2, 1 ) ) / s;
+		}
+		else if( m( 1, 1 ) > m( 2, 2 ) )
+		{
+			T s = sqrt( 1.0f + m( 1, 1 ) - m( 0, 0 ) - m( 2, 2 ) ) * 2.0f;
+			x = ( m( 0, 1 ) + m( 1, 0 ) ) / s;
+			y = 0.25f * s;
+			z = ( m( 1, 2 ) + m( 2, 1 ) ) / s;
+			w = ( m( 0, 2 ) - m( 2, 0 ) ) / s;
+		}
+		else
+		{
+			T s = sqrt( 1.0f + m( 2, 2 ) - m( 0, 0 ) - m( 1, 1 ) ) * 2.0f;
+			x = ( m( 0, 2 ) + m( 2, 0 ) ) / s;
+			y = ( m( 1, 2 ) + m( 2, 1 ) ) / s;
+			z = 0.25f * s;
+			w = ( m( 0, 1 ) - m( 1, 0 ) ) / s;
+		}
+	}
+
+	Quat4< T > q( w, x, y, z );
+	return q.normalized();
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::fromRotatedBasis( const Vector3< T >& x, const Vector3< T >& y, const Vector3< T >& z )
+{
+	// Matrix3f is float only
+	return fromRotationMatrix( Matrix3f( Vector3f( x ), Vector3f( y ), Vector3f( z ) ) );
+}
+
+// static
+template< typename T >
+Quat4< T > Quat4< T >::randomRotation( T u0, T u1, T u2 )
+{
+	T z = u0;
+	T theta = static_cast< T >( 2.f * M_PI * u1 );
+	T r = sqrt( 1.f - z * z );
+	T w = static_cast< T >( M_PI * u2 );
+
+	return Quat4< T >
+	(
+		cos( w ),
+		sin( w ) * cos( theta ) * r,
+		sin( w ) * sin( theta ) * r,
+		sin( w ) * z
+	);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+
+template< typename T >
+Quat4< T > operator + ( const Quat4< T >& q0, const Quat4< T >& q1 )
+{
+	return Quat4< T >
+	(
+		q0.w() + q1.w(),
+		q0.x() + q1.x(),
+		q0.y() + q1.y(),
+		q0.z() + q1.z()
+	);
+}
+
+template< typename T >
+Quat4< T > operator - ( const Quat4< T >& q0, const Quat4< T >& q1 )
+{
+	return Quat4< T >
+	(
+		q0.w() - q1.w(),
+		q0.x() - q1.x(),
+		q0.y() - q1.y(),
+		q0.z() - q1.z()
+	);
+}
+
+template< typename T >
+Quat4< T > operator * ( const Quat4< T >& q0, const Quat4< T >& q1 )
+{
+	return Quat4< T >
+	(
+		q0.w() * q1.w() - q0.x() * q1.x() - q0.y() * q1.y() - q0.z() * q1.z(),
+		q0.w() * q1.x() + q0.x() * q1.w() + q0.y() * q1.z() - q0.z() * q1.y(),
+		q0.w() * q1.y() - q0.x() * q1.z() + q0.y() * q1.w() + q0.z() * q1.x(),
+		q0.w() * q1.z() + q0.x() * q1.y() - q0.y() * q1.x() + q0.z() * q1.w()
+	);
+}
+
+template< typename T >
+Quat4< T > operator * ( typename Quat4< T >::value_type f, const Quat4< T >& q )
+{
+	return Quat4< T >
+	(
+		f * q.w(),
+		f * q.x(),
+		f * q.y(),
+		f * q.z()
+	);
+}
+
+template< typename T >
+Quat4< T > operator * ( const Quat4< T >& q, typename Quat4< T >::value_type f )
+{
+	return Quat4< T >
+	(
+		f * q.w(),
+		f * q.x(),
+		f * q.y(),
+		f * q.z()
+	);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Eigen version for float, see vecmath_eigen.h
+//////////////////////////////////////////////////////////////////////////
+
+#ifdef VECMATH_EIGEN
+
+// Eigen::Quaternionf stores ( x, y, z, w ), Quat4f stores ( w, x, y, z )
+template<>
+VECMATH_INLINE Quat4< float > operator * ( const Quat4< float >& q0, const Quat4< float >& q1 )
+{
+	Eigen::Quaternionf product = Eigen::Quaternionf( q0.w(), q0.x(), q0.y(), q0.z() ) *
+		Eigen::Quaternionf( q1.w(), q1.x(), q1.y(), q1.z() );
+	return Quat4< float >( product.w(), product.x(), product.y(), product.z() );
+}
+
+#endif // VECMATH_EIGEN
+
+#endif // QUAT4F_INL
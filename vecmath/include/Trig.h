@@ -0,0 +1,58 @@
+#ifndef TRIG_H
+#define TRIG_H
+
+#include <vector>
+
+// Sines and cosines for tessellation loops (spheres, cylinders, circles,
+// surfaces of revolution), which need the same few angles over and over.
+
+namespace vecmath_trig
+{
+	// 2 pi, the range of a full turn
+	const float TWO_PI = 6.28318530717958647692f;
+
+	// sines[ i ] = sin( angles[ i ] ), cosines[ i ] = cos( angles[ i ] ) for
+	// i < n, four angles at a time with SSE. Accurate to a few ulp for
+	// |angle| up to about 1e4.
+	void sincos( const float* angles, int n, float* sines, float* cosines );
+}
+
+// sin and cos of the n + 1 angles i * range / n, i = 0..n, e.g. the
+// longitudes of a sphere with n slices. For a full turn the last entry is
+// exactly the first, so closed loops meet without a seam.
+class AngleTable
+{
+public:
+
+	AngleTable( int steps, float range = vecmath_trig::TWO_PI );
+
+	// Shared table for steps and range, computed on first use and kept for
+	// the lifetime of the program. Safe to call from several threads.
+	static const AngleTable& get( int steps, float range = vecmath_trig::TWO_PI );
+
+	int steps() const;
+	float range() const;
+
+	// i in [ 0, steps() ]
+	float angle( int i ) const;
+	float sin( int i ) const;
+	float cos( int i ) const;
+
+	// steps() + 1 values each
+	const float* sines() const;
+	const float* cosines() const;
+
+private:
+
+	int m_steps;
+	float m_range;
+	std::vector< float > m_sines;
+	std::vector< float > m_cosines;
+
+};
+
+#ifdef VECMATH_HEADER_ONLY
+#include "Trig.inl"
+#endif
+
+#endif // TRIG_H
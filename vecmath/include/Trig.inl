@@ -0,0 +1,187 @@
+#ifndef TRIG_INL
+#define TRIG_INL
+
+#include "Trig.h"
+
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "vecmath_inline.h"
+#include "vecmath_simd.h"
+
+// Both versions below reduce the angle to r in [ -pi/4, pi/4 ] and a
+// quadrant q, with pi/2 split into three parts so that r stays exact, and
+// evaluate the minimax polynomials of the Cephes sinf/cosf on r:
+//
+//     q = 0: ( sin r, cos r )      q = 1: ( cos r, -sin r )
+//     q = 2: ( -sin r, -cos r )    q = 3: ( -cos r, sin r )
+
+namespace vecmath_trig
+{
+	const float TWO_OVER_PI = 0.636619772367581343076f;
+	const float PI_OVER_2_A = 1.5703125f;
+	const float PI_OVER_2_B = 4.837512969970703125e-4f;
+	const float PI_OVER_2_C = 7.54978995489188216e-8f;
+
+	const float SIN_P0 = -1.9515295891e-4f;
+	const float SIN_P1 = 8.3321608736e-3f;
+	const float SIN_P2 = -1.6666654611e-1f;
+	const float COS_P0 = 2.443315711809948e-5f;
+	const float COS_P1 = -1.388731625493765e-3f;
+	const float COS_P2 = 4.166664568298827e-2f;
+
+	// one angle, used without SSE2 and for the last n % 4 angles
+	VECMATH_INLINE void sincosScalar( float x, float& s, float& c )
+	{
+		float qf = std::floor( x * TWO_OVER_PI + 0.5f );
+		int q = ( int )qf;
+		float r = ( ( x - qf * PI_OVER_2_A ) - qf * PI_OVER_2_B ) - qf * PI_OVER_2_C;
+		float z = r * r;
+		float sr = ( ( SIN_P0 * z + SIN_P1 ) * z + SIN_P2 ) * z * r + r;
+		float cr = ( ( COS_P0 * z + COS_P1 ) * z + COS_P2 ) * z * z - 0.5f * z + 1.0f;
+
+		if( q & 1 )
+		{
+			s = cr;
+			c = sr;
+		}
+		else
+		{
+			s = sr;
+			c = cr;
+		}
+		if( q & 2 )
+		{
+			s = -s;
+		}
+		if( ( q + 1 ) & 2 )
+		{
+			c = -c;
+		}
+	}
+
+	VECMATH_INLINE void sincos( const float* angles, int n, float* sines, float* cosines )
+	{
+		assert( n >= 0 );
+		int i = 0;
+#ifdef VECMATH_SSE2
+		const __m128i one = _mm_set1_epi32( 1 );
+		const __m128i two = _mm_set1_epi32( 2 );
+		for( ; i + 4 <= n; i += 4 )
+		{
+			__m128 x = _mm_loadu_ps( angles + i );
+			__m128i q = _mm_cvtps_epi32( _mm_mul_ps( x, _mm_set1_ps( TWO_OVER_PI ) ) );
+			__m128 qf = _mm_cvtepi32_ps( q );
+
+			__m128 r = _mm_sub_ps( x, _mm_mul_ps( qf, _mm_set1_ps( PI_OVER_2_A ) ) );
+			r = _mm_sub_ps( r, _mm_mul_ps( qf, _mm_set1_ps( PI_OVER_2_B ) ) );
+			r = _mm_sub_ps( r, _mm_mul_ps( qf, _mm_set1_ps( PI_OVER_2_C ) ) );
+			__m128 z = _mm_mul_ps( r, r );
+
+			__m128 sr = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( SIN_P0 ), z ), _mm_set1_ps( SIN_P1 ) );
+			sr = _mm_add_ps( _mm_mul_ps( sr, z ), _mm_set1_ps( SIN_P2 ) );
+			sr = _mm_add_ps( _mm_mul_ps( _mm_mul_ps( sr, z ), r ), r );
+
+			__m128 cr = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( COS_P0 ), z ), _mm_set1_ps( COS_P1 ) );
+			cr = _mm_add_ps( _mm_mul_ps( cr, z ), _mm_set1_ps( COS_P2 ) );
+			cr = _mm_mul_ps( _mm_mul_ps( cr, z ), z );
+			cr = _mm_add_ps( _mm_sub_ps( cr, _mm_mul_ps( _mm_set1_ps( 0.5f ), z ) ), _mm_set1_ps( 1.0f ) );
+
+			// swap where q is odd, then flip the signs by quadrant
+			__m128 swap = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( q, one ), one ) );
+			__m128 s = _mm_or_ps( _mm_and_ps( swap, cr ), _mm_andnot_ps( swap, sr ) );
+			__m128 c = _mm_or_ps( _mm_and_ps( swap, sr ), _mm_andnot_ps( swap, cr ) );
+			__m128 sinSign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( q, two ), 30 ) );
+			__m128 cosSign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( _mm_add_epi32( q, one ), two ), 30 ) );
+
+			_mm_storeu_ps( sines + i, _mm_xor_ps( s, sinSign ) );
+			_mm_storeu_ps( cosines + i, _mm_xor_ps( c, cosSign ) );
+		}
+#endif
+		for( ; i < n; ++i )
+		{
+			sincosScalar( angles[ i ], sines[ i ], cosines[ i ] );
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// AngleTable
+//////////////////////////////////////////////////////////////////////////
+
+VECMATH_INLINE AngleTable::AngleTable( int steps, float range ) :
+	m_steps( steps ),
+	m_range( range ),
+	m_sines( steps + 1 ),
+	m_cosines( steps + 1 )
+{
+	assert( steps > 0 );
+	std::vector< float > angles( steps + 1 );
+	for( int i = 0; i <= steps; ++i )
+	{
+		angles[ i ] = angle( i );
+	}
+	vecmath_trig::sincos( &( angles[ 0 ] ), steps + 1, &( m_sines[ 0 ] ), &( m_cosines[ 0 ] ) );
+
+	if( range == vecmath_trig::TWO_PI )
+	{
+		m_sines[ steps ] = m_sines[ 0 ];
+		m_cosines[ steps ] = m_cosines[ 0 ];
+	}
+}
+
+// static
+VECMATH_INLINE const AngleTable& AngleTable::get( int steps, float range )
+{
+	static std::mutex mutex;
+	static std::map< std::pair< int, float >, AngleTable > tables;
+
+	std::lock_guard< std::mutex > lock( mutex );
+	std::pair< int, float > key( steps, range );
+	std::map< std::pair< int, float >, AngleTable >::iterator it = tables.find( key );
+	if( it == tables.end() )
+	{
+		it = tables.insert( std::make_pair( key, AngleTable( steps, range ) ) ).first;
+	}
+	return it->second;
+}
+
+VECMATH_INLINE int AngleTable::steps() const
+{
+	return m_steps;
+}
+
+VECMATH_INLINE float AngleTable::range() const
+{
+	return m_range;
+}
+
+VECMATH_INLINE float AngleTable::angle( int i ) const
+{
+	return m_range * float( i ) / m_steps;
+}
+
+VECMATH_INLINE float AngleTable::sin( int i ) const
+{
+	return m_sines[ i ];
+}
+
+VECMATH_INLINE float AngleTable::cos( int i ) const
+{
+	return m_cosines[ i ];
+}
+
+VECMATH_INLINE const float* AngleTable::sines() const
+{
+	return &( m_sines[ 0 ] );
+}
+
+VECMATH_INLINE const float* AngleTable::cosines() const
+{
+	return &( m_cosines[ 0 ] );
+}
+
+#endif // TRIG_INL
@@ -3,7 +3,7 @@
 
 #include <cmath>
 
-class Vector3f;
+#include "vecmath_fwd.h"
 
 class Vector2f
 {
@@ -88,4 +88,8 @@ Vector2f operator / ( const Vector2f& v, float f );
 bool operator == ( const Vector2f& v0, const Vector2f& v1 );
 bool operator != ( const Vector2f& v0, const Vector2f& v1 );
 
+#ifdef VECMATH_HEADER_ONLY
+#include "Vector2f.inl"
+#endif
+
 #endif // VECTOR_2F_H
@@ -0,0 +1,155 @@
+#ifndef VECTOR_3F_H
+#define VECTOR_3F_H
+
+#include <vector>
+
+#include "vecmath_fwd.h"
+#include "vecmath_inline.h"
+
+class Vector2f;
+
+// 3-component vector, Vector3f for float and Vector3d for double
+template< typename T >
+class Vector3
+{
+public:
+
+	typedef T value_type;
+
+	static const Vector3 ZERO;
+	static const Vector3 UP;
+	static const Vector3 RIGHT;
+	static const Vector3 FORWARD;
+
+    explicit Vector3( T f = 0 );
+    Vector3( T x, T y, T z );
+
+	Vector3( const Vector2f& xy, T z );
+	Vector3( T x, const Vector2f& yz );
+
+	// copy constructors
+    Vector3( const Vector3& rv );
+
+	// converts from another precision, e.g. Vector3f( Vector3d( ... ) )
+	template< typename U >
+	explicit Vector3( const Vector3< U >& rv );
+
+	// assignment operators
+    Vector3& operator = ( const Vector3& rv );
+
+	// no destructor necessary
+
+	// returns the ith element
+    const T& operator [] ( int i ) const;
+    T& operator [] ( int i );
+
+    T& x();
+	T& y();
+	T& z();
+
+	T x() const;
+	T y() const;
+	T z() const;
+
+	Vector2f xy() const;
+	Vector2f xz() const;
+	Vector2f yz() const;
+
+	Vector3 xyz() const;
+	Vector3 yzx() const;
+	Vector3 zxy() const;
+
+	T abs() const;
+    T absSquared() const;
+
+	void normalize();
+	Vector3 normalized() const;
+
+	Vector2f homogenized() const;
+
+	void negate();
+
+	// ---- Utility ----
+    operator const T* () const; // automatic type conversion for OpenGL
+    operator T* (); // automatic type conversion for OpenGL 
+	void print() const;	
+
+	Vector3& operator += ( const Vector3& v );
+	Vector3& operator -= ( const Vector3& v );
+  Vector3& operator *= ( T f );
+  Vector3& operator /= (T f );
+
+  static T dot( const Vector3& v0, const Vector3& v1 );
+	static Vector3 cross( const Vector3& v0, const Vector3& v1 );
+    
+    // computes the linear interpolation between v0 and v1 by alpha \in [0,1]
+	// returns v0 * ( 1 - alpha ) * v1 * alpha
+	static Vector3 lerp( const Vector3& v0, const Vector3& v1, T alpha );
+
+	// computes the cubic catmull-rom interpolation between p0, p1, p2, p3
+    // by t \in [0,1].  Guarantees that at t = 0, the result is p0 and
+    // at p1, the result is p2.
+	static Vector3 cubicInterpolate( const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, T t );
+
+private:
+
+	T m_elements[ 3 ];
+
+};
+
+// component-wise operators
+template< typename T > Vector3< T > operator + ( const Vector3< T >& v0, const Vector3< T >& v1 );
+template< typename T > Vector3< T > operator - ( const Vector3< T >& v0, const Vector3< T >& v1 );
+template< typename T > Vector3< T > operator * ( const Vector3< T >& v0, const Vector3< T >& v1 );
+template< typename T > Vector3< T > operator / ( const Vector3< T >& v0, const Vector3< T >& v1 );
+
+// unary negation
+template< typename T > Vector3< T > operator - ( const Vector3< T >& v );
+
+// multiply and divide by scalar
+// (value_type is not deduced, so 0.5 * v and 2 * v work for any T)
+template< typename T > Vector3< T > operator * ( typename Vector3< T >::value_type f, const Vector3< T >& v );
+template< typename T > Vector3< T > operator * ( const Vector3< T >& v, typename Vector3< T >::value_type f );
+template< typename T > Vector3< T > operator / ( const Vector3< T >& v, typename Vector3< T >::value_type f );
+
+
+#ifdef VECMATH_EIGEN
+// Eigen versions for float, defined at the end of Vector3f.inl
+template<> VECMATH_INLINE float Vector3< float >::dot( const Vector3< float >& v0, const Vector3< float >& v1 );
+template<> VECMATH_INLINE Vector3< float > Vector3< float >::cross( const Vector3< float >& v0, const Vector3< float >& v1 );
+#endif
+
+template< typename T > bool operator == ( const Vector3< T >& v0, const Vector3< T >& v1 );
+template< typename T > bool operator != ( const Vector3< T >& v0, const Vector3< T >& v1 );
+
+// out[ i ] = Vector3< T >( in[ i ] ), e.g. to render double precision state
+template< typename T, typename U >
+void convertArray( const std::vector< Vector3< U > >& in, std::vector< Vector3< T > >& out );
+
+// Member and function templates that are not instantiated in the library
+// for every type, so they are defined here in both build modes.
+
+template< typename T >
+template< typename U >
+Vector3< T >::Vector3( const Vector3< U >& rv )
+{
+	m_elements[ 0 ] = static_cast< T >( rv[ 0 ] );
+	m_elements[ 1 ] = static_cast< T >( rv[ 1 ] );
+	m_elements[ 2 ] = static_cast< T >( rv[ 2 ] );
+}
+
+template< typename T, typename U >
+void convertArray( const std::vector< Vector3< U > >& in, std::vector< Vector3< T > >& out )
+{
+	out.resize( in.size() );
+	for( std::size_t i = 0; i < in.size(); ++i )
+	{
+		out[ i ] = Vector3< T >( in[ i ] );
+	}
+}
+
+#ifdef VECMATH_HEADER_ONLY
+#include "Vector3f.inl"
+#endif
+
+#endif // VECTOR_3F_H
@@ -0,0 +1,396 @@
+#ifndef VECTOR_3F_INL
+#define VECTOR_3F_INL
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Vector3f.h"
+#include "Vector2f.h"
+#include "vecmath_eigen.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Public
+//////////////////////////////////////////////////////////////////////////
+
+template< typename T >
+Vector3< T >::Vector3( T f )
+{
+    m_elements[0] = f;
+    m_elements[1] = f;
+    m_elements[2] = f;
+}
+
+template< typename T >
+Vector3< T >::Vector3( T x, T y, T z )
+{
+    m_elements[0] = x;
+    m_elements[1] = y;
+    m_elements[2] = z;
+}
+
+template< typename T >
+Vector3< T >::Vector3( const Vector2f& xy, T z )
+{
+	m_elements[0] = xy.x();
+	m_elements[1] = xy.y();
+	m_elements[2] = z;
+}
+
+template< typename T >
+Vector3< T >::Vector3( T x, const Vector2f& yz )
+{
+	m_elements[0] = x;
+	m_elements[1] = yz.x();
+	m_elements[2] = yz.y();
+}
+
+template< typename T >
+Vector3< T >::Vector3( const Vector3< T >& rv )
+{
+    m_elements[0] = rv[0];
+    m_elements[1] = rv[1];
+    m_elements[2] = rv[2];
+}
+
+template< typename T >
+Vector3< T >& Vector3< T >::operator = ( const Vector3< T >& rv )
+{
+    if( this != &rv )
+    {
+        m_elements[0] = rv[0];
+        m_elements[1] = rv[1];
+        m_elements[2] = rv[2];
+    }
+    return *this;
+}
+
+template< typename T >
+const T& Vector3< T >::operator [] ( int i ) const
+{
+    return m_elements[i];
+}
+
+template< typename T >
+T& Vector3< T >::operator [] ( int i )
+{
+    return m_elements[i];
+}
+
+template< typename T >
+T& Vector3< T >::x()
+{
+    return m_elements[0];
+}
+
+template< typename T >
+T& Vector3< T >::y()
+{
+    return m_elements[1];
+}
+
+template< typename T >
+T& Vector3< T >::z()
+{
+    return m_elements[2];
+}
+
+template< typename T >
+T Vector3< T >::x() const
+{
+    return m_elements[0];
+}
+
+template< typename T >
+T Vector3< T >::y() const
+{
+    return m_elements[1];
+}
+
+template< typename T >
+T Vector3< T >::z() const
+{
+    return m_elements[2];
+}
+
+template< typename T >
+Vector2f Vector3< T >::xy() const
+{
+	return Vector2f( m_elements[0], m_elements[1] );
+}
+
+template< typename T >
+Vector2f Vector3< T >::xz() const
+{
+	return Vector2f( m_elements[0], m_elements[2] );
+}
+
+template< typename T >
+Vector2f Vector3< T >::yz() const
+{
+	return Vector2f( m_elements[1], m_elements[2] );
+}
+
+template< typename T >
+Vector3< T > Vector3< T >::xyz() const
+{
+	return Vector3< T >( m_elements[0], m_elements[1], m_elements[2] );
+}
+
+template< typename T >
+Vector3< T > Vector3< T >::yzx() const
+{
+	return Vector3< T >( m_elements[1], m_elements[2], m_elements[0] );
+}
+
+template< typename T >
+Vector3< T > Vector3< T >::zxy() const
+{
+	return Vector3< T >( m_elements[2], m_elements[0], m_elements[1] );
+}
+
+template< typename T >
+T Vector3< T >::abs() const
+{
+	return sqrt( m_elements[0] * m_elements[0] + m_elements[1] * m_elements[1] + m_elements[2] * m_elements[2] );
+}
+
+template< typename T >
+T Vector3< T >::absSquared() const
+{
+    return
+        (
+            m_elements[0] * m_elements[0] +
+            m_elements[1] * m_elements[1] +
+            m_elements[2] * m_elements[2]
+        );
+}
+
+template< typename T >
+void Vector3< T >::normalize()
+{
+	T norm = abs();
+	m_elements[0] /= norm;
+	m_elements[1] /= norm;
+	m_elements[2] /= norm;
+}
+
+template< typename T >
+Vector3< T > Vector3< T >::normalized() const
+{
+	T norm = abs();
+	return Vector3< T >
+		(
+			m_elements[0] / norm,
+			m_elements[1] / norm,
+			m_elements[2] / norm
+		);
+}
+
+template< typename T >
+Vector2f Vector3< T >::homogenized() const
+{
+	return Vector2f
+		(
+			m_elements[ 0 ] / m_elements[ 2 ],
+			m_elements[ 1 ] / m_elements[ 2 ]
+		);
+}
+
+template< typename T >
+void Vector3< T >::negate()
+{
+	m_elements[0] = -m_elements[0];
+	m_elements[1] = -m_elements[1];
+	m_elements[2] = -m_elements[2];
+}
+
+template< typename T >
+Vector3< T >::operator const T* () const
+{
+    return m_elements;
+}
+
+template< typename T >
+Vector3< T >::operator T* ()
+{
+    return m_elements;
+}
+
+template< typename T >
+void Vector3< T >::print() const
+{
+	printf( "< %.4f, %.4f, %.4f >\n",
+		m_elements[0], m_elements[1], m_elements[2] );
+}
+
+template< typename T >
+Vector3< T >& Vector3< T >::operator += ( const Vector3< T >& v )
+{
+	m_elements[ 0 ] += v.m_elements[ 0 ];
+	m_elements[ 1 ] += v.m_elements[ 1 ];
+	m_elements[ 2 ] += v.m_elements[ 2 ];
+	return *this;
+}
+
+template< typename T >
+Vector3< T >& Vector3< T >::operator -= ( const Vector3< T >& v )
+{
+	m_elements[ 0 ] -= v.m_elements[ 0 ];
+	m_elements[ 1 ] -= v.m_elements[ 1 ];
+	m_elements[ 2 ] -= v.m_elements[ 2 ];
+	return *this;
+}
+
+template< typename T >
+Vector3< T >& Vector3< T >::operator *= ( T f )
+{
+	m_elements[ 0 ] *= f;
+	m_elements[ 1 ] *= f;
+	m_elements[ 2 ] *= f;
+	return *this;
+}
+
+template< typename T >
+Vector3< T >& Vector3< T >::operator /= ( T f )
+{
+  m_elements[ 0 ] /= f;
+  m_elements[ 1 ] /= f;
+  m_elements[ 2 ] /= f;
+  return *this;
+}
+
+// static
+template< typename T >
+T Vector3< T >::dot( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2];
+}
+
+// static
+template< typename T >
+Vector3< T > Vector3< T >::cross( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return Vector3< T >
+        (
+            v0.y() * v1.z() - v0.z() * v1.y(),
+            v0.z() * v1.x() - v0.x() * v1.z(),
+            v0.x() * v1.y() - v0.y() * v1.x()
+        );
+}
+
+// static
+template< typename T >
+Vector3< T > Vector3< T >::lerp( const Vector3< T >& v0, const Vector3< T >& v1, T alpha )
+{
+	return alpha * ( v1 - v0 ) + v0;
+}
+
+// static
+template< typename T >
+Vector3< T > Vector3< T >::cubicInterpolate( const Vector3< T >& p0, const Vector3< T >& p1, const Vector3< T >& p2, const Vector3< T >& p3, T t )
+{
+	// geometric construction:
+	//            t
+	//   (t+1)/2     t/2
+	// t+1        t	        t-1
+
+	// bottom level
+	Vector3< T > p0p1 = Vector3< T >::lerp( p0, p1, t + 1 );
+	Vector3< T > p1p2 = Vector3< T >::lerp( p1, p2, t );
+	Vector3< T > p2p3 = Vector3< T >::lerp( p2, p3, t - 1 );
+
+	// middle level
+	Vector3< T > p0p1_p1p2 = Vector3< T >::lerp( p0p1, p1p2, 0.5f * ( t + 1 ) );
+	Vector3< T > p1p2_p2p3 = Vector3< T >::lerp( p1p2, p2p3, 0.5f * t );
+
+	// top level
+	return Vector3< T >::lerp( p0p1_p1p2, p1p2_p2p3, t );
+}
+
+template< typename T >
+Vector3< T > operator + ( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return Vector3< T >( v0[0] + v1[0], v0[1] + v1[1], v0[2] + v1[2] );
+}
+
+template< typename T >
+Vector3< T > operator - ( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return Vector3< T >( v0[0] - v1[0], v0[1] - v1[1], v0[2] - v1[2] );
+}
+
+template< typename T >
+Vector3< T > operator * ( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return Vector3< T >( v0[0] * v1[0], v0[1] * v1[1], v0[2] * v1[2] );
+}
+
+template< typename T >
+Vector3< T > operator / ( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return Vector3< T >( v0[0] / v1[0], v0[1] / v1[1], v0[2] / v1[2] );
+}
+
+template< typename T >
+Vector3< T > operator - ( const Vector3< T >& v )
+{
+    return Vector3< T >( -v[0], -v[1], -v[2] );
+}
+
+template< typename T >
+Vector3< T > operator * ( typename Vector3< T >::value_type f, const Vector3< T >& v )
+{
+    return Vector3< T >( v[0] * f, v[1] * f, v[2] * f );
+}
+
+template< typename T >
+Vector3< T > operator * ( const Vector3< T >& v, typename Vector3< T >::value_type f )
+{
+    return Vector3< T >( v[0] * f, v[1] * f, v[2] * f );
+}
+
+template< typename T >
+Vector3< T > operator / ( const Vector3< T >& v, typename Vector3< T >::value_type f )
+{
+    return Vector3< T >( v[0] / f, v[1] / f, v[2] / f );
+}
+
+template< typename T >
+bool operator == ( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return( v0.x() == v1.x() && v0.y() == v1.y() && v0.z() == v1.z() );
+}
+
+template< typename T >
+bool operator != ( const Vector3< T >& v0, const Vector3< T >& v1 )
+{
+    return !( v0 == v1 );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Eigen versions for float, see vecmath_eigen.h
+//////////////////////////////////////////////////////////////////////////
+
+#ifdef VECMATH_EIGEN
+
+// static
+template<>
+VECMATH_INLINE float Vector3< float >::dot( const Vector3< float >& v0, const Vector3< float >& v1 )
+{
+	return vecmath_eigen::ConstVector3Map( v0 ).dot( vecmath_eigen::ConstVector3Map( v1 ) );
+}
+
+// static
+template<>
+VECMATH_INLINE Vector3< float > Vector3< float >::cross( const Vector3< float >& v0, const Vector3< float >& v1 )
+{
+	Vector3< float > out;
+	vecmath_eigen::Vector3Map result( out );
+	result = vecmath_eigen::ConstVector3Map( v0 ).cross( vecmath_eigen::ConstVector3Map( v1 ) );
+	return out;
+}
+
+#endif // VECMATH_EIGEN
+
+#endif // VECTOR_3F_INL
@@ -0,0 +1,93 @@
+#ifndef VECTOR_3F_ARRAY_H
+#define VECTOR_3F_ARRAY_H
+
+#include <vector>
+
+#include "Vector3f.h"
+
+// Array of Vector3f stored as structure of arrays: all x components are
+// contiguous, followed by all y and all z components. Each component array
+// is 32-byte aligned and zero-padded to a multiple of 8 floats, so loops over
+// x(), y() and z() vectorize without the 12-byte stride of
+// std::vector< Vector3f >. The bulk operations below use SSE directly.
+class Vector3fArray
+{
+public:
+
+	// Proxy for element i, so that a[ i ] can be read and assigned like a Vector3f.
+	class Reference
+	{
+	public:
+		Reference( Vector3fArray& array, int i );
+
+		operator Vector3f () const;
+		Reference& operator = ( const Vector3f& v );
+		Reference& operator = ( const Reference& r );
+		Reference& operator += ( const Vector3f& v );
+
+		float& x();
+		float& y();
+		float& z();
+
+	private:
+		Vector3fArray& m_array;
+		int m_index;
+	};
+
+	explicit Vector3fArray( int size = 0 );
+	explicit Vector3fArray( const std::vector< Vector3f >& v );
+
+	Vector3fArray( const Vector3fArray& a );
+	Vector3fArray& operator = ( const Vector3fArray& a );
+	~Vector3fArray();
+
+	int size() const;
+	// new elements are zero
+	void resize( int size );
+
+	Reference operator [] ( int i );
+	Vector3f operator [] ( int i ) const;
+
+	// component arrays, each size() floats long
+	float* x();
+	float* y();
+	float* z();
+	const float* x() const;
+	const float* y() const;
+	const float* z() const;
+
+	// ---- Conversion ----
+	void assign( const std::vector< Vector3f >& v );
+	void copyTo( std::vector< Vector3f >& v ) const;
+	std::vector< Vector3f > toVector() const;
+
+	// ---- Bulk operations, sizes must match ----
+	void fill( const Vector3f& v );
+	// this += a * v
+	void axpy( float a, const Vector3fArray& v );
+	// this *= a
+	void scale( float a );
+	// this += v
+	void add( const Vector3fArray& v );
+	// normalizes every element, zero-length elements stay zero
+	void normalize();
+
+private:
+
+	void reallocate( int capacity );
+	// size rounded up to a multiple of 8, at most the capacity
+	int paddedSize() const;
+
+	float* m_buffer; // as allocated, m_x is the aligned start within it
+	float* m_x;
+	int m_size;
+	int m_capacity; // floats per component array, a multiple of 8
+	                // elements past m_size are kept at zero
+
+};
+
+#ifdef VECMATH_HEADER_ONLY
+#include "Vector3fArray.inl"
+#endif
+
+#endif // VECTOR_3F_ARRAY_H
@@ -0,0 +1,334 @@
+#ifndef VECTOR_3F_ARRAY_INL
+#define VECTOR_3F_ARRAY_INL
+
+#include "Vector3fArray.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "vecmath_inline.h"
+#include "vecmath_simd.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Reference
+//////////////////////////////////////////////////////////////////////////
+
+VECMATH_INLINE Vector3fArray::Reference::Reference( Vector3fArray& array, int i ) :
+	m_array( array ),
+	m_index( i )
+{
+
+}
+
+VECMATH_INLINE Vector3fArray::Reference::operator Vector3f () const
+{
+	const Vector3fArray& a = m_array;
+	return a[ m_index ];
+}
+
+VECMATH_INLINE Vector3fArray::Reference& Vector3fArray::Reference::operator = ( const Vector3f& v )
+{
+	x() = v[ 0 ];
+	y() = v[ 1 ];
+	z() = v[ 2 ];
+	return *this;
+}
+
+VECMATH_INLINE Vector3fArray::Reference& Vector3fArray::Reference::operator = ( const Reference& r )
+{
+	return *this = Vector3f( r );
+}
+
+VECMATH_INLINE Vector3fArray::Reference& Vector3fArray::Reference::operator += ( const Vector3f& v )
+{
+	x() += v[ 0 ];
+	y() += v[ 1 ];
+	z() += v[ 2 ];
+	return *this;
+}
+
+VECMATH_INLINE float& Vector3fArray::Reference::x()
+{
+	return m_array.x()[ m_index ];
+}
+
+VECMATH_INLINE float& Vector3fArray::Reference::y()
+{
+	return m_array.y()[ m_index ];
+}
+
+VECMATH_INLINE float& Vector3fArray::Reference::z()
+{
+	return m_array.z()[ m_index ];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Vector3fArray
+//////////////////////////////////////////////////////////////////////////
+
+VECMATH_INLINE Vector3fArray::Vector3fArray( int size ) :
+	m_buffer( NULL ),
+	m_x( NULL ),
+	m_size( 0 ),
+	m_capacity( 0 )
+{
+	resize( size );
+}
+
+VECMATH_INLINE Vector3fArray::Vector3fArray( const std::vector< Vector3f >& v ) :
+	m_buffer( NULL ),
+	m_x( NULL ),
+	m_size( 0 ),
+	m_capacity( 0 )
+{
+	assign( v );
+}
+
+VECMATH_INLINE Vector3fArray::Vector3fArray( const Vector3fArray& a ) :
+	m_buffer( NULL ),
+	m_x( NULL ),
+	m_size( 0 ),
+	m_capacity( 0 )
+{
+	*this = a;
+}
+
+VECMATH_INLINE Vector3fArray& Vector3fArray::operator = ( const Vector3fArray& a )
+{
+	if( this != &a )
+	{
+		resize( a.m_size );
+		memcpy( x(), a.x(), m_size * sizeof( float ) );
+		memcpy( y(), a.y(), m_size * sizeof( float ) );
+		memcpy( z(), a.z(), m_size * sizeof( float ) );
+	}
+	return *this;
+}
+
+VECMATH_INLINE Vector3fArray::~Vector3fArray()
+{
+	delete[] m_buffer;
+}
+
+VECMATH_INLINE int Vector3fArray::size() const
+{
+	return m_size;
+}
+
+VECMATH_INLINE void Vector3fArray::resize( int size )
+{
+	assert( size >= 0 );
+	if( size > m_capacity )
+	{
+		reallocate( ( size + 7 ) & ~7 );
+	}
+	if( size < m_size )
+	{
+		// keep everything past the end zero
+		memset( x() + size, 0, ( m_size - size ) * sizeof( float ) );
+		memset( y() + size, 0, ( m_size - size ) * sizeof( float ) );
+		memset( z() + size, 0, ( m_size - size ) * sizeof( float ) );
+	}
+	m_size = size;
+}
+
+VECMATH_INLINE Vector3fArray::Reference Vector3fArray::operator [] ( int i )
+{
+	return Reference( *this, i );
+}
+
+VECMATH_INLINE Vector3f Vector3fArray::operator [] ( int i ) const
+{
+	return Vector3f( x()[ i ], y()[ i ], z()[ i ] );
+}
+
+VECMATH_INLINE float* Vector3fArray::x()
+{
+	return m_x;
+}
+
+VECMATH_INLINE float* Vector3fArray::y()
+{
+	return m_x + m_capacity;
+}
+
+VECMATH_INLINE float* Vector3fArray::z()
+{
+	return m_x + 2 * m_capacity;
+}
+
+VECMATH_INLINE const float* Vector3fArray::x() const
+{
+	return m_x;
+}
+
+VECMATH_INLINE const float* Vector3fArray::y() const
+{
+	return m_x + m_capacity;
+}
+
+VECMATH_INLINE const float* Vector3fArray::z() const
+{
+	return m_x + 2 * m_capacity;
+}
+
+VECMATH_INLINE void Vector3fArray::assign( const std::vector< Vector3f >& v )
+{
+	resize( ( int )v.size() );
+	float* px = x();
+	float* py = y();
+	float* pz = z();
+	for( int i = 0; i < m_size; ++i )
+	{
+		px[ i ] = v[ i ][ 0 ];
+		py[ i ] = v[ i ][ 1 ];
+		pz[ i ] = v[ i ][ 2 ];
+	}
+}
+
+VECMATH_INLINE void Vector3fArray::copyTo( std::vector< Vector3f >& v ) const
+{
+	v.resize( m_size );
+	const float* px = x();
+	const float* py = y();
+	const float* pz = z();
+	for( int i = 0; i < m_size; ++i )
+	{
+		v[ i ] = Vector3f( px[ i ], py[ i ], pz[ i ] );
+	}
+}
+
+VECMATH_INLINE std::vector< Vector3f > Vector3fArray::toVector() const
+{
+	std::vector< Vector3f > v;
+	copyTo( v );
+	return v;
+}
+
+VECMATH_INLINE void Vector3fArray::fill( const Vector3f& v )
+{
+	float* px = x();
+	float* py = y();
+	float* pz = z();
+	for( int i = 0; i < m_size; ++i )
+	{
+		px[ i ] = v[ 0 ];
+		py[ i ] = v[ 1 ];
+		pz[ i ] = v[ 2 ];
+	}
+}
+
+// The bulk operations run over whole blocks of 4 floats, including the
+// zero padding up to the capacity, so there is no remainder loop.
+
+VECMATH_INLINE void Vector3fArray::axpy( float a, const Vector3fArray& v )
+{
+	assert( v.m_size == m_size );
+	int n = paddedSize();
+	for( int c = 0; c < 3; ++c )
+	{
+		float* dst = m_x + c * m_capacity;
+		const float* src = v.m_x + c * v.m_capacity;
+#ifdef VECMATH_SSE
+		__m128 va = _mm_set1_ps( a );
+		for( int i = 0; i < n; i += 4 )
+		{
+			_mm_store_ps( dst + i, _mm_add_ps( _mm_load_ps( dst + i ), _mm_mul_ps( va, _mm_load_ps( src + i ) ) ) );
+		}
+#else
+		for( int i = 0; i < n; ++i )
+		{
+			dst[ i ] += a * src[ i ];
+		}
+#endif
+	}
+}
+
+VECMATH_INLINE void Vector3fArray::scale( float a )
+{
+	int n = paddedSize();
+	for( int c = 0; c < 3; ++c )
+	{
+		float* dst = m_x + c * m_capacity;
+#ifdef VECMATH_SSE
+		__m128 va = _mm_set1_ps( a );
+		for( int i = 0; i < n; i += 4 )
+		{
+			_mm_store_ps( dst + i, _mm_mul_ps( va, _mm_load_ps( dst + i ) ) );
+		}
+#else
+		for( int i = 0; i < n; ++i )
+		{
+			dst[ i ] *= a;
+		}
+#endif
+	}
+}
+
+VECMATH_INLINE void Vector3fArray::add( const Vector3fArray& v )
+{
+	axpy( 1.0f, v );
+}
+
+VECMATH_INLINE void Vector3fArray::normalize()
+{
+	float* px = x();
+	float* py = y();
+	float* pz = z();
+#ifdef VECMATH_SSE
+	int n = paddedSize();
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps( 1.0f );
+	for( int i = 0; i < n; i += 4 )
+	{
+		__m128 vx = _mm_load_ps( px + i );
+		__m128 vy = _mm_load_ps( py + i );
+		__m128 vz = _mm_load_ps( pz + i );
+		__m128 norm = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( vx, vx ), _mm_mul_ps( vy, vy ) ), _mm_mul_ps( vz, vz ) ) );
+		__m128 reciprocal = _mm_and_ps( _mm_cmpgt_ps( norm, zero ), _mm_div_ps( one, norm ) );
+		_mm_store_ps( px + i, _mm_mul_ps( vx, reciprocal ) );
+		_mm_store_ps( py + i, _mm_mul_ps( vy, reciprocal ) );
+		_mm_store_ps( pz + i, _mm_mul_ps( vz, reciprocal ) );
+	}
+#else
+	for( int i = 0; i < m_size; ++i )
+	{
+		float norm = sqrt( px[ i ] * px[ i ] + py[ i ] * py[ i ] + pz[ i ] * pz[ i ] );
+		if( norm > 0 )
+		{
+			px[ i ] /= norm;
+			py[ i ] /= norm;
+			pz[ i ] /= norm;
+		}
+	}
+#endif
+}
+
+VECMATH_INLINE int Vector3fArray::paddedSize() const
+{
+	return ( m_size + 7 ) & ~7;
+}
+
+VECMATH_INLINE void Vector3fArray::reallocate( int capacity )
+{
+	// zero-initialized, 8 extra floats leave room to align the start to 32 bytes
+	float* buffer = new float[ 3 * capacity + 8 ]();
+	float* aligned = reinterpret_cast< float* >( ( reinterpret_cast< size_t >( buffer ) + 31 ) & ~size_t( 31 ) );
+
+	for( int c = 0; c < 3; ++c )
+	{
+		if( m_size > 0 )
+		{
+			memcpy( aligned + c * capacity, m_x + c * m_capacity, m_size * sizeof( float ) );
+		}
+	}
+
+	delete[] m_buffer;
+	m_buffer = buffer;
+	m_x = aligned;
+	m_capacity = capacity;
+}
+
+#endif // VECTOR_3F_ARRAY_INL
@@ -1,8 +1,9 @@
 #ifndef VECTOR_4F_H
 #define VECTOR_4F_H
 
+#include "vecmath_fwd.h"
+
 class Vector2f;
-class Vector3f;
 
 class Vector4f
 {
@@ -99,4 +100,8 @@ Vector4f operator / ( const Vector4f& v, float f );
 bool operator == ( const Vector4f& v0, const Vector4f& v1 );
 bool operator != ( const Vector4f& v0, const Vector4f& v1 );
 
+#ifdef VECMATH_HEADER_ONLY
+#include "Vector4f.inl"
+#endif
+
 #endif // VECTOR_4F_H
@@ -0,0 +1,358 @@
+#ifndef VECTOR_EXPR_H
+#define VECTOR_EXPR_H
+
+// Expression templates for element-wise arithmetic on arrays of Vector3f.
+//
+// Writing
+//
+//     for( i ) out[ i ] = s[ i ] + h / 6 * ( k1[ i ] + 2 * k2[ i ] + 2 * k3[ i ] + k4[ i ] );
+//
+// with the Vector3f operators creates a temporary Vector3f for every
+// operator and, unless VECMATH_HEADER_ONLY is set, calls each operator out
+// of line. With this header the same update is
+//
+//     using namespace vecmath_expr;
+//     evaluate( out, expr( s ) + h / 6 * ( expr( k1 ) + 2 * expr( k2 ) + 2 * expr( k3 ) + expr( k4 ) ) );
+//
+// which builds a small expression object at compile time and evaluates it
+// in one pass over the arrays, component by component, without temporaries.
+//
+// Operands are std::vector< Vector3f >, Vector3fArray or a single Vector3f
+// (used for every element), or the Vector3d versions of the first and the
+// last; all operands of one expression have the same scalar type. Array
+// operands must have the same size. The
+// destination may also appear in the expression, since element i of the
+// result only reads element i of the operands.
+//
+// This header is opt-in and not included by vecmath.h.
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "Vector3f.h"
+#include "Vector3fArray.h"
+
+namespace vecmath_expr
+{
+	// Base of all expressions; E( i, c ) is component c of element i and
+	// E::Scalar its type.
+	template< typename E >
+	struct Expr
+	{
+		const E& self() const
+		{
+			return static_cast< const E& >( *this );
+		}
+	};
+
+	// ---- Operands ----
+
+	// std::vector< Vector3< T > >, read through a flat pointer so that no
+	// out-of-line Vector3 accessor is called per element
+	template< typename T >
+	class VectorOperand : public Expr< VectorOperand< T > >
+	{
+	public:
+		typedef T Scalar;
+
+		explicit VectorOperand( const std::vector< Vector3< T > >& v ) :
+			m_data( v.empty() ? NULL : ( const T* )v[ 0 ] ),
+			m_size( ( int )v.size() )
+		{
+			static_assert( sizeof( Vector3< T > ) == 3 * sizeof( T ), "Vector3 must be three packed scalars" );
+		}
+
+		T operator () ( int i, int c ) const
+		{
+			return m_data[ 3 * i + c ];
+		}
+
+		int size() const
+		{
+			return m_size;
+		}
+
+	private:
+		const T* m_data;
+		int m_size;
+	};
+
+	class ArrayOperand : public Expr< ArrayOperand >
+	{
+	public:
+		typedef float Scalar;
+
+		explicit ArrayOperand( const Vector3fArray& a ) :
+			m_size( a.size() )
+		{
+			m_components[ 0 ] = a.x();
+			m_components[ 1 ] = a.y();
+			m_components[ 2 ] = a.z();
+		}
+
+		float operator () ( int i, int c ) const
+		{
+			return m_components[ c ][ i ];
+		}
+
+		int size() const
+		{
+			return m_size;
+		}
+
+	private:
+		const float* m_components[ 3 ];
+		int m_size;
+	};
+
+	// the same Vector3< T > for every element
+	template< typename T >
+	class ConstantOperand : public Expr< ConstantOperand< T > >
+	{
+	public:
+		typedef T Scalar;
+
+		explicit ConstantOperand( const Vector3< T >& v )
+		{
+			const T* p = v;
+			m_v[ 0 ] = p[ 0 ];
+			m_v[ 1 ] = p[ 1 ];
+			m_v[ 2 ] = p[ 2 ];
+		}
+
+		T operator () ( int, int c ) const
+		{
+			return m_v[ c ];
+		}
+
+		// matches any array size
+		int size() const
+		{
+			return -1;
+		}
+
+	private:
+		T m_v[ 3 ];
+	};
+
+	template< typename T >
+	VectorOperand< T > expr( const std::vector< Vector3< T > >& v )
+	{
+		return VectorOperand< T >( v );
+	}
+
+	inline ArrayOperand expr( const Vector3fArray& a )
+	{
+		return ArrayOperand( a );
+	}
+
+	template< typename T >
+	ConstantOperand< T > expr( const Vector3< T >& v )
+	{
+		return ConstantOperand< T >( v );
+	}
+
+	// ---- Operators ----
+
+	inline int combinedSize( int s0, int s1 )
+	{
+		assert( s0 < 0 || s1 < 0 || s0 == s1 );
+		return s0 < 0 ? s1 : s0;
+	}
+
+	struct Add
+	{
+		template< typename T > static T apply( T a, T b ) { return a + b; }
+	};
+
+	struct Subtract
+	{
+		template< typename T > static T apply( T a, T b ) { return a - b; }
+	};
+
+	struct Multiply
+	{
+		template< typename T > static T apply( T a, T b ) { return a * b; }
+	};
+
+	template< typename L, typename R, typename Op >
+	class BinaryExpr : public Expr< BinaryExpr< L, R, Op > >
+	{
+	public:
+		typedef typename L::Scalar Scalar;
+		static_assert( std::is_same< Scalar, typename R::Scalar >::value, "operands must have the same scalar type" );
+
+		BinaryExpr( const L& l, const R& r ) :
+			m_l( l ),
+			m_r( r )
+		{
+
+		}
+
+		Scalar operator () ( int i, int c ) const
+		{
+			return Op::apply( m_l( i, c ), m_r( i, c ) );
+		}
+
+		int size() const
+		{
+			return combinedSize( m_l.size(), m_r.size() );
+		}
+
+	private:
+		L m_l;
+		R m_r;
+	};
+
+	template< typename E >
+	class ScaledExpr : public Expr< ScaledExpr< E > >
+	{
+	public:
+		typedef typename E::Scalar Scalar;
+
+		ScaledExpr( Scalar s, const E& e ) :
+			m_s( s ),
+			m_e( e )
+		{
+
+		}
+
+		Scalar operator () ( int i, int c ) const
+		{
+			return m_s * m_e( i, c );
+		}
+
+		int size() const
+		{
+			return m_e.size();
+		}
+
+	private:
+		Scalar m_s;
+		E m_e;
+	};
+
+	template< typename L, typename R >
+	BinaryExpr< L, R, Add > operator + ( const Expr< L >& l, const Expr< R >& r )
+	{
+		return BinaryExpr< L, R, Add >( l.self(), r.self() );
+	}
+
+	template< typename L, typename R >
+	BinaryExpr< L, R, Subtract > operator - ( const Expr< L >& l, const Expr< R >& r )
+	{
+		return BinaryExpr< L, R, Subtract >( l.self(), r.self() );
+	}
+
+	// component-wise product
+	template< typename L, typename R >
+	BinaryExpr< L, R, Multiply > operator * ( const Expr< L >& l, const Expr< R >& r )
+	{
+		return BinaryExpr< L, R, Multiply >( l.self(), r.self() );
+	}
+
+	template< typename E >
+	ScaledExpr< E > operator * ( typename E::Scalar s, const Expr< E >& e )
+	{
+		return ScaledExpr< E >( s, e.self() );
+	}
+
+	template< typename E >
+	ScaledExpr< E > operator * ( const Expr< E >& e, typename E::Scalar s )
+	{
+		return ScaledExpr< E >( s, e.self() );
+	}
+
+	template< typename E >
+	ScaledExpr< E > operator / ( const Expr< E >& e, typename E::Scalar s )
+	{
+		return ScaledExpr< E >( 1 / s, e.self() );
+	}
+
+	template< typename E >
+	ScaledExpr< E > operator - ( const Expr< E >& e )
+	{
+		return ScaledExpr< E >( -1, e.self() );
+	}
+
+	// ---- Evaluation ----
+
+	// out = e, resizing out to the size of the array operands. Elements are
+	// evaluated in blocks of 8 into a local buffer: the buffer cannot alias
+	// the operands, so the block loop vectorizes without run-time overlap
+	// checks.
+	template< typename T, typename E >
+	void evaluate( std::vector< Vector3< T > >& out, const Expr< E >& e )
+	{
+		static_assert( std::is_same< T, typename E::Scalar >::value, "out must have the scalar type of the expression" );
+		const E& x = e.self();
+		int n = x.size();
+		assert( n >= 0 );
+		out.resize( n );
+		if( n == 0 )
+		{
+			return;
+		}
+		T* p = out[ 0 ];
+		int i = 0;
+		for( ; i + 8 <= n; i += 8 )
+		{
+			T block[ 24 ];
+			for( int k = 0; k < 8; ++k )
+			{
+				block[ 3 * k ] = x( i + k, 0 );
+				block[ 3 * k + 1 ] = x( i + k, 1 );
+				block[ 3 * k + 2 ] = x( i + k, 2 );
+			}
+			for( int k = 0; k < 24; ++k )
+			{
+				p[ 3 * i + k ] = block[ k ];
+			}
+		}
+		for( ; i < n; ++i )
+		{
+			for( int c = 0; c < 3; ++c )
+			{
+				p[ 3 * i + c ] = x( i, c );
+			}
+		}
+	}
+
+	// The same for Vector3fArray, one component after the other so that the
+	// block loop reads and writes contiguous floats.
+	template< typename E >
+	void evaluate( Vector3fArray& out, const Expr< E >& e )
+	{
+		static_assert( std::is_same< float, typename E::Scalar >::value, "Vector3fArray holds floats" );
+		const E& x = e.self();
+		int n = x.size();
+		assert( n >= 0 );
+		out.resize( n );
+		float* components[ 3 ] = { out.x(), out.y(), out.z() };
+		for( int c = 0; c < 3; ++c )
+		{
+			float* p = components[ c ];
+			int i = 0;
+			for( ; i + 8 <= n; i += 8 )
+			{
+				float block[ 8 ];
+				for( int k = 0; k < 8; ++k )
+				{
+					block[ k ] = x( i + k, c );
+				}
+				for( int k = 0; k < 8; ++k )
+				{
+					p[ i + k ] = block[ k ];
+				}
+			}
+			for( ; i < n; ++i )
+			{
+				p[ i ] = x( i, c );
+			}
+		}
+	}
+}
+
+#endif // VECTOR_EXPR_H
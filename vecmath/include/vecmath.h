@@ -1,12 +1,15 @@
 #ifndef VECMATH_H
 #define VECMATH_H
 
+#include "Affine3f.h"
 #include "Matrix2f.h"
 #include "Matrix3f.h"
 #include "Matrix4f.h"
 #include "Quat4f.h"
+#include "Trig.h"
 #include "Vector2f.h"
 #include "Vector3f.h"
+#include "Vector3fArray.h"
 #include "Vector4f.h"
 
 #endif // VECMATH_H
@@ -0,0 +1,36 @@
+#ifndef VECMATH_EIGEN_H
+#define VECMATH_EIGEN_H
+
+// Eigen backend.
+//
+// Defining VECMATH_EIGEN (CMake option VECMATH_EIGEN=ON) implements the
+// float kernels of Matrix4f, Vector4f, Vector3f and Quat4f with Eigen's
+// fixed-size types instead of the hand-written SSE/AVX code: the products,
+// inverse and transpose of Matrix4f, the Vector4f arithmetic, dot and cross
+// products, and the quaternion product. The vecmath classes keep their
+// storage and API; the kernels map Eigen types onto the existing elements,
+// so there is no copy and no alignment requirement.
+//
+// Eigen is header-only; CMake uses the copy that ships with nanogui in
+// assn2 unless VECMATH_EIGEN_DIR points elsewhere.
+
+#ifdef VECMATH_EIGEN
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/LU>
+
+namespace vecmath_eigen
+{
+	// vecmath stores matrices column major, as Eigen does by default
+	typedef Eigen::Map< Eigen::Matrix4f > Matrix4Map;
+	typedef Eigen::Map< const Eigen::Matrix4f > ConstMatrix4Map;
+	typedef Eigen::Map< Eigen::Vector4f > Vector4Map;
+	typedef Eigen::Map< const Eigen::Vector4f > ConstVector4Map;
+	typedef Eigen::Map< Eigen::Vector3f > Vector3Map;
+	typedef Eigen::Map< const Eigen::Vector3f > ConstVector3Map;
+}
+
+#endif
+
+#endif // VECMATH_EIGEN_H
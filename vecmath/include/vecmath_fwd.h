@@ -0,0 +1,23 @@
+#ifndef VECMATH_FWD_H
+#define VECMATH_FWD_H
+
+// Vector3, Matrix4 and Quat4 are templates on the scalar type. The float
+// versions keep their old names and are what the assignments use; the
+// double versions are for state that needs the extra precision, e.g. long
+// running simulations. Vector2f, Vector4f, Matrix2f, Matrix3f and Affine3f
+// are float only.
+
+template< typename T > class Vector3;
+template< typename T > class Matrix4;
+template< typename T > class Quat4;
+
+typedef Vector3< float > Vector3f;
+typedef Vector3< double > Vector3d;
+
+typedef Matrix4< float > Matrix4f;
+typedef Matrix4< double > Matrix4d;
+
+typedef Quat4< float > Quat4f;
+typedef Quat4< double > Quat4d;
+
+#endif // VECMATH_FWD_H
@@ -0,0 +1,19 @@
+#ifndef VECMATH_INLINE_H
+#define VECMATH_INLINE_H
+
+// Header-only build mode.
+//
+// By default the vecmath definitions in the .inl files are compiled once into
+// the vecmath library. Defining VECMATH_HEADER_ONLY (CMake option
+// VECMATH_HEADER_ONLY=ON) makes every header pull in its .inl file and marks
+// the definitions inline, so accessors and operators can be inlined into the
+// caller's loops. Only the static constants (Vector3f::ZERO, ...) still live
+// in the library.
+
+#ifdef VECMATH_HEADER_ONLY
+#define VECMATH_INLINE inline
+#else
+#define VECMATH_INLINE
+#endif
+
+#endif // VECMATH_INLINE_H
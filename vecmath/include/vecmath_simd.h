@@ -0,0 +1,49 @@
+#ifndef VECMATH_SIMD_H
+#define VECMATH_SIMD_H
+
+// Compile-time selection of the SIMD kernels used by Matrix4f, Vector4f,
+// Vector3fArray and vecmath_trig::sincos.
+//
+// SSE is used whenever the target supports it (always the case on x86-64).
+// The AVX kernels are used in addition when compiling with -mavx or /arch:AVX.
+// Define VECMATH_NO_SIMD to force the scalar reference implementation,
+// e.g. to compare results against the vectorized code.
+
+#if !defined( VECMATH_NO_SIMD ) && \
+	( defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 ) )
+#define VECMATH_SSE 1
+#include <xmmintrin.h>
+#endif
+
+#ifdef VECMATH_SSE
+namespace vecmath_sse
+{
+	// (x, y, z, 0) from three consecutive floats, e.g. a Vector3f
+	inline __m128 load3( const float* p )
+	{
+		__m128 xy = _mm_loadl_pi( _mm_setzero_ps(), ( const __m64* )p );
+		return _mm_movelh_ps( xy, _mm_load_ss( p + 2 ) );
+	}
+
+	// writes x, y, z without touching p[ 3 ]
+	inline void store3( float* p, __m128 r )
+	{
+		_mm_storel_pi( ( __m64* )p, r );
+		_mm_store_ss( p + 2, _mm_movehl_ps( r, r ) );
+	}
+}
+#endif
+
+// SSE2 integer operations, also always available on x86-64
+#if defined( VECMATH_SSE ) && \
+	( defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) )
+#define VECMATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined( VECMATH_SSE ) && defined( __AVX__ )
+#define VECMATH_AVX 1
+#include <immintrin.h>
+#endif
+
+#endif // VECMATH_SIMD_H
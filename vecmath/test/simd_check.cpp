@@ -0,0 +1,237 @@
+// Checks the Matrix4f and Vector4f kernels (SSE/AVX, Eigen or scalar,
+// whichever this build uses, see include/vecmath_simd.h) against plain
+// scalar loops on random input. The products, transpose and Vector4f
+// arithmetic keep the scalar order of operations and must match exactly;
+// the inverse must leave a small A * inverse - I residual relative to the
+// conditioning of A. Exits non-zero on the first kind of mismatch found.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "vecmath.h"
+
+namespace
+{
+
+const int MATRICES = 20000;
+
+int failures = 0;
+
+float randUniform( float lo, float hi )
+{
+	return lo + ( hi - lo ) * ( float )rand() / RAND_MAX;
+}
+
+Matrix4f randomMatrix()
+{
+	Matrix4f m;
+	for( int i = 0; i < 16; ++i )
+	{
+		m[ i ] = randUniform( -10.0f, 10.0f );
+	}
+	return m;
+}
+
+Vector4f randomVector()
+{
+	return Vector4f( randUniform( -10.0f, 10.0f ), randUniform( -10.0f, 10.0f ),
+		randUniform( -10.0f, 10.0f ), randUniform( -10.0f, 10.0f ) );
+}
+
+// Like the generic Matrix4< T > operators: each entry is summed from
+// zero in order of j. The SIMD kernels add the same products in the same
+// order, so the results are identical.
+void referenceProduct( const Matrix4f& x, const Matrix4f& y, float* out )
+{
+	for( int i = 0; i < 4; ++i )
+	{
+		for( int k = 0; k < 4; ++k )
+		{
+			float sum = 0;
+			for( int j = 0; j < 4; ++j )
+			{
+				sum += x( i, j ) * y( j, k );
+			}
+			out[ 4 * k + i ] = sum;
+		}
+	}
+}
+
+void referenceProduct( const Matrix4f& m, const Vector4f& v, float* out )
+{
+	for( int i = 0; i < 4; ++i )
+	{
+		float sum = 0;
+		for( int j = 0; j < 4; ++j )
+		{
+			sum += m( i, j ) * v[ j ];
+		}
+		out[ i ] = sum;
+	}
+}
+
+float maxAbsRowSum( const Matrix4f& m )
+{
+	float norm = 0;
+	for( int i = 0; i < 4; ++i )
+	{
+		float sum = 0;
+		for( int j = 0; j < 4; ++j )
+		{
+			sum += std::fabs( m( i, j ) );
+		}
+		norm = sum > norm ? sum : norm;
+	}
+	return norm;
+}
+
+// reports the first few mismatches of each check
+bool check( bool ok, const char* what, int iteration )
+{
+	if( !ok )
+	{
+		if( failures < 10 )
+		{
+			printf( "FAIL %s, iteration %d\n", what, iteration );
+		}
+		++failures;
+	}
+	return ok;
+}
+
+bool equal( const float* a, const float* b, int n )
+{
+	for( int i = 0; i < n; ++i )
+	{
+		if( a[ i ] != b[ i ] )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+int main()
+{
+	srand( 1 );
+
+	// worst A * inverse - I entry relative to the condition number, over
+	// all matrices; a few float epsilons is expected
+	float worstResidual = 0;
+
+	for( int it = 0; it < MATRICES; ++it )
+	{
+		Matrix4f a = randomMatrix();
+		Matrix4f b = randomMatrix();
+		Vector4f u = randomVector();
+		Vector4f v = randomVector();
+		float f = randUniform( -10.0f, 10.0f );
+
+		float expected[ 16 ];
+		referenceProduct( a, b, expected );
+		Matrix4f product = a * b;
+		check( equal( product, expected, 16 ), "matrix * matrix", it );
+
+		referenceProduct( a, v, expected );
+		Vector4f mv = a * v;
+		check( equal( mv, expected, 4 ), "matrix * vector", it );
+
+		Matrix4f t = a.transposed();
+		for( int i = 0; i < 4; ++i )
+		{
+			for( int j = 0; j < 4; ++j )
+			{
+				expected[ 4 * j + i ] = a( j, i );
+			}
+		}
+		check( equal( t, expected, 16 ), "transpose", it );
+
+		for( int i = 0; i < 4; ++i )
+		{
+			expected[ i ] = u[ i ] + v[ i ];
+		}
+		check( equal( u + v, expected, 4 ), "vector + vector", it );
+		for( int i = 0; i < 4; ++i )
+		{
+			expected[ i ] = u[ i ] - v[ i ];
+		}
+		check( equal( u - v, expected, 4 ), "vector - vector", it );
+		for( int i = 0; i < 4; ++i )
+		{
+			expected[ i ] = u[ i ] * v[ i ];
+		}
+		check( equal( u * v, expected, 4 ), "vector * vector", it );
+		for( int i = 0; i < 4; ++i )
+		{
+			expected[ i ] = u[ i ] / v[ i ];
+		}
+		check( equal( u / v, expected, 4 ), "vector / vector", it );
+		for( int i = 0; i < 4; ++i )
+		{
+			expected[ i ] = f * u[ i ];
+		}
+		check( equal( f * u, expected, 4 ) && equal( u * f, expected, 4 ), "vector * scalar", it );
+		for( int i = 0; i < 4; ++i )
+		{
+			expected[ i ] = -u[ i ];
+		}
+		check( equal( -u, expected, 4 ), "-vector", it );
+
+		bool singular = true;
+		Matrix4f inverse = a.inverse( &singular );
+		if( !check( !singular, "inverse of a regular matrix reported singular", it ) )
+		{
+			continue;
+		}
+		// A * inverse in double, so that only the error of the inverse shows
+		float condition = maxAbsRowSum( a ) * maxAbsRowSum( inverse );
+		float residual = 0;
+		for( int i = 0; i < 4; ++i )
+		{
+			for( int k = 0; k < 4; ++k )
+			{
+				double sum = 0;
+				for( int j = 0; j < 4; ++j )
+				{
+					sum += double( a( i, j ) ) * inverse( j, k );
+				}
+				float e = ( float )std::fabs( sum - ( i == k ? 1.0 : 0.0 ) ) / condition;
+				residual = e > residual ? e : residual;
+			}
+		}
+		worstResidual = residual > worstResidual ? residual : worstResidual;
+		check( residual < 1e-5f, "inverse residual", it );
+	}
+
+	// a matrix with a zero row has a determinant of exactly zero, which
+	// counts as singular once epsilon is above zero
+	Matrix4f singularMatrix( 1, 2, 3, 4,
+		0, 0, 0, 0,
+		0, 1, 0, 1,
+		1, 0, 1, 0 );
+	bool singular = false;
+	singularMatrix.inverse( &singular, 1e-6f );
+	check( singular, "inverse of a singular matrix not reported singular", 0 );
+
+#if defined( VECMATH_EIGEN )
+	const char* kernels = "eigen";
+#elif defined( VECMATH_AVX )
+	const char* kernels = "avx";
+#elif defined( VECMATH_SSE )
+	const char* kernels = "sse";
+#else
+	const char* kernels = "scalar";
+#endif
+	printf( "vecmath kernels: %s\n", kernels );
+	printf( "%d matrices, worst relative inverse residual %g\n", MATRICES, worstResidual );
+	if( failures > 0 )
+	{
+		printf( "%d checks FAILED\n", failures );
+		return 1;
+	}
+	printf( "all checks passed\n" );
+	return 0;
+}